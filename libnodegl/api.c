@@ -19,6 +19,7 @@
  * under the License.
  */
 
+#include <inttypes.h>
 #include <stdlib.h>
 #include <pthread.h>
 #include <stdio.h>
@@ -41,8 +42,9 @@
 #include "memory.h"
 #include "nodegl.h"
 #include "nodes.h"
-#include "pgcache.h"
+#include "rendertarget.h"
 #include "rnode.h"
+#include "sharegroup.h"
 
 #if defined(HAVE_VAAPI)
 #include "vaapi_ctx.h"
@@ -85,9 +87,8 @@ static int cmd_stop(struct ngl_ctx *s, void *arg)
 #if defined(TARGET_ANDROID)
     ngli_android_ctx_reset(&s->android_ctx);
 #endif
-    ngli_texture_freep(&s->font_atlas); // allocated by the first node text
-    ngli_pgcache_reset(&s->pgcache);
     ngli_hud_freep(&s->hud);
+    ngli_sharegroup_unrefp(&s->sharegroup, s->gctx);
     ngli_gctx_freep(&s->gctx);
 
     return 0;
@@ -95,14 +96,16 @@ static int cmd_stop(struct ngl_ctx *s, void *arg)
 
 static int cmd_configure(struct ngl_ctx *s, void *arg)
 {
-    struct ngl_config *config = arg;
-
     if (s->scene)
         ngli_node_detach_ctx(s->scene, s);
     ngli_rnode_clear(&s->rnode);
 
     cmd_stop(s, arg);
 
+    /* work on a copy so the configuration of the caller is left untouched */
+    s->config = *(const struct ngl_config *)arg;
+    struct ngl_config *config = &s->config;
+
     if (config->backend == NGL_BACKEND_AUTO)
         config->backend = DEFAULT_BACKEND;
 
@@ -113,7 +116,19 @@ static int cmd_configure(struct ngl_ctx *s, void *arg)
         return config->platform;
     }
 
-    s->config = *config;
+    struct ngl_ctx *share_ctx = config->share_ctx;
+    if (share_ctx) {
+        if (share_ctx->config.backend != config->backend ||
+            share_ctx->config.platform != config->platform) {
+            LOG(ERROR, "share context must use the same platform and backend");
+            return NGL_ERROR_INVALID_ARG;
+        }
+        config->display = ngli_gctx_get_display(share_ctx->gctx);
+        config->handle = ngli_gctx_get_handle(share_ctx->gctx);
+    }
+
+    s->frame_changed = 1;
+    s->last_capture_buffer = NULL;
 
     s->gctx = ngli_gctx_create(config);
     if (!s->gctx)
@@ -129,9 +144,10 @@ static int cmd_configure(struct ngl_ctx *s, void *arg)
     s->rnode_pos->graphicstate = NGLI_GRAPHICSTATE_DEFAULTS;
     s->rnode_pos->rendertarget_desc = *ngli_gctx_get_default_rendertarget_desc(s->gctx);
 
-    ret = ngli_pgcache_init(&s->pgcache, s->gctx);
-    if (ret < 0)
-        return ret;
+    s->sharegroup = share_ctx ? ngli_sharegroup_ref(share_ctx->sharegroup)
+                              : ngli_sharegroup_create(s->gctx);
+    if (!s->sharegroup)
+        return NGL_ERROR_MEMORY;
 
 #if defined(HAVE_VAAPI)
     ret = ngli_vaapi_ctx_init(s->gctx, &s->vaapi_ctx);
@@ -184,6 +200,7 @@ struct resize_params {
 static int cmd_resize(struct ngl_ctx *s, void *arg)
 {
     const struct resize_params *params = arg;
+    s->frame_changed = 1;
     return ngli_gctx_resize(s->gctx, params->width, params->height, params->viewport);
 }
 
@@ -218,11 +235,18 @@ static int cmd_set_scene(struct ngl_ctx *s, void *arg)
     s->rnode_pos->graphicstate = NGLI_GRAPHICSTATE_DEFAULTS;
     s->rnode_pos->rendertarget_desc = *ngli_gctx_get_default_rendertarget_desc(s->gctx);
 
+    s->frame_changed = 1;
+
     struct ngl_node *scene = arg;
-    if (!scene)
+    if (!scene) {
+        ngli_profile_stop_recording(&s->profile);
         return 0;
+    }
 
+    ngli_profile_start_recording(&s->profile);
+    ngli_profile_start(&s->profile, NULL, NGLI_PROFILE_PHASE_SET_SCENE);
     int ret = ngli_node_attach_ctx(scene, s);
+    ngli_profile_stop(&s->profile);
     if (ret < 0) {
         ngli_node_detach_ctx(scene, s);
         return ret;
@@ -246,6 +270,35 @@ static int cmd_set_scene(struct ngl_ctx *s, void *arg)
     return 0;
 }
 
+/*
+ * The amount of memory held by each branch is unknown, so only the kept warm
+ * branch needed the furthest in time (disabled UserSwitch branches first) is
+ * evicted; it will be released during
+ * the next frame visit, and the next candidate considered if the budget is
+ * still exceeded at that point.
+ */
+static void enforce_memory_budget(struct ngl_ctx *s)
+{
+    const int64_t budget = s->config.gpu_memory_budget;
+    if (budget <= 0 || s->gctx->memory_usage <= budget)
+        return;
+
+    struct eviction_candidate *candidates = ngli_darray_data(&s->eviction_candidates);
+    const int nb_candidates = ngli_darray_count(&s->eviction_candidates);
+    struct eviction_candidate *furthest = NULL;
+    for (int i = 0; i < nb_candidates; i++) {
+        struct eviction_candidate *candidate = &candidates[i];
+        if (!furthest || candidate->next_use > furthest->next_use)
+            furthest = candidate;
+    }
+    if (!furthest)
+        return;
+
+    LOG(DEBUG, "GPU memory usage %" PRId64 " exceeds budget %" PRId64 ", evict %s (next use in %g)",
+        s->gctx->memory_usage, budget, furthest->node->label, furthest->next_use);
+    *furthest->evict = 1;
+}
+
 static int cmd_prepare_draw(struct ngl_ctx *s, void *arg)
 {
     const double t = *(double *)arg;
@@ -259,7 +312,10 @@ static int cmd_prepare_draw(struct ngl_ctx *s, void *arg)
 
     const int64_t start_time = s->hud ? ngli_gettime_relative() : 0;
 
+    s->block_upload_size = 0;
+
     ngli_darray_clear(&s->activitycheck_nodes);
+    ngli_darray_clear(&s->eviction_candidates);
     int ret = ngli_node_visit(scene, 1, t);
     if (ret < 0)
         return ret;
@@ -268,7 +324,10 @@ static int cmd_prepare_draw(struct ngl_ctx *s, void *arg)
     if (ret < 0)
         return ret;
 
+    enforce_memory_budget(s);
+
     ret = ngli_node_update(scene, t);
+    ngli_hwconv_end_batch(s);
     if (ret < 0)
         return ret;
 
@@ -277,7 +336,22 @@ static int cmd_prepare_draw(struct ngl_ctx *s, void *arg)
     return 0;
 }
 
-static int cmd_draw(struct ngl_ctx *s, void *arg)
+/*
+ * Whether the frame of the last draw can be reused as is. The time dependent
+ * nodes flag the frame as changed during the update, and the live changes,
+ * new scene and resize invalidate it as well. This is restricted to offscreen
+ * rendering since the onscreen presentation relies on the buffer swap, and to
+ * CPU capture where the default rendertarget can be read back again if the
+ * capture buffer changed.
+ */
+static int can_reuse_frame(const struct ngl_ctx *s)
+{
+    const struct ngl_config *config = &s->config;
+    return config->offscreen && !s->hud && !s->frame_changed &&
+           config->capture_buffer_type == NGL_CAPTURE_BUFFER_TYPE_CPU;
+}
+
+static int draw_frame(struct ngl_ctx *s, void *arg)
 {
     const double t = *(double *)arg;
 
@@ -285,9 +359,16 @@ static int cmd_draw(struct ngl_ctx *s, void *arg)
     if (ret < 0)
         return ret;
 
-    ret = ngli_gctx_begin_draw(s->gctx, t);
-    if (ret < 0)
-        goto end;
+    if (can_reuse_frame(s)) {
+        void *capture_buffer = s->config.capture_buffer;
+        if (capture_buffer && capture_buffer != s->last_capture_buffer) {
+            struct rendertarget *rt = ngli_gctx_get_default_rendertarget(s->gctx);
+            ngli_rendertarget_read_pixels(rt, capture_buffer);
+            s->last_capture_buffer = capture_buffer;
+        }
+        LOG(DEBUG, "frame @ t=%f is identical to the previous one, skip drawing", t);
+        return 0;
+    }
 
     const int64_t cpu_start_time = s->hud ? ngli_gettime_relative() : 0;
 
@@ -295,9 +376,18 @@ static int cmd_draw(struct ngl_ctx *s, void *arg)
     s->available_rendertargets[0] = rt;
     s->available_rendertargets[1] = rt;
     s->current_rendertarget = rt;
-    s->begin_render_pass = 0;
+    s->begin_render_pass = 1;
 
+    /* the default render pass is begun by the graphics context */
     struct ngl_node *scene = s->scene;
+    if (scene)
+        ngli_node_draw_hoisted(scene);
+
+    ret = ngli_gctx_begin_draw(s->gctx, t);
+    if (ret < 0)
+        goto end;
+    s->begin_render_pass = 0;
+
     if (scene) {
         LOG(DEBUG, "draw scene %s @ t=%f", scene->label, t);
         ngli_node_draw(scene);
@@ -321,17 +411,60 @@ end:;
     if (end_ret < 0)
         return end_ret;
 
+    if (ret >= 0) {
+        s->frame_changed = 0;
+        s->last_capture_buffer = s->config.capture_buffer;
+    }
+
     return ret;
 }
 
+static int cmd_draw(struct ngl_ctx *s, void *arg)
+{
+    struct profile *profile = &s->profile;
+    if (!profile->recording)
+        return draw_frame(s, arg);
+
+    ngli_profile_start(profile, NULL, NGLI_PROFILE_PHASE_FIRST_DRAW);
+    int ret = draw_frame(s, arg);
+    ngli_profile_stop(profile);
+    ngli_profile_stop_recording(profile);
+    return ret;
+}
+
+static int cmd_get_startup_profile(struct ngl_ctx *s, void *arg)
+{
+    char **reportp = arg;
+    *reportp = ngli_profile_get_report(&s->profile);
+    return *reportp ? 0 : NGL_ERROR_MEMORY;
+}
+
+static int cmd_get_shaders(struct ngl_ctx *s, void *arg)
+{
+    char **shadersp = arg;
+    *shadersp = ngli_pgcache_dump(&s->sharegroup->pgcache);
+    return *shadersp ? 0 : NGL_ERROR_MEMORY;
+}
+
+/* Must be called with the context lock held */
+static void wait_cmd(struct ngl_ctx *s)
+{
+    while (s->cmd_func)
+        pthread_cond_wait(&s->cond_ctl, &s->lock);
+    if (s->cmd_async) {
+        s->async_ret = s->cmd_ret;
+        s->cmd_async = 0;
+    }
+}
+
 static int dispatch_cmd(struct ngl_ctx *s, cmd_func_type cmd_func, void *arg)
 {
     pthread_mutex_lock(&s->lock);
+    wait_cmd(s); // a previous asynchronous command may still be running
     s->cmd_func = cmd_func;
     s->cmd_arg = arg;
     pthread_cond_signal(&s->cond_wkr);
-    while (s->cmd_func)
-        pthread_cond_wait(&s->cond_ctl, &s->lock);
+    wait_cmd(s);
     pthread_mutex_unlock(&s->lock);
 
     return s->cmd_ret;
@@ -583,6 +716,9 @@ struct ngl_ctx *ngl_create(void)
     ngli_darray_init(&s->modelview_matrix_stack, 4 * 4 * sizeof(float), 1);
     ngli_darray_init(&s->projection_matrix_stack, 4 * 4 * sizeof(float), 1);
     ngli_darray_init(&s->activitycheck_nodes, sizeof(struct ngl_node *), 0);
+    ngli_darray_init(&s->eviction_candidates, sizeof(struct eviction_candidate), 0);
+    ngli_darray_init(&s->hoist_reads, sizeof(struct ngl_node *), 0);
+    ngli_profile_init(&s->profile);
 
     static const NGLI_ALIGNED_MAT(id_matrix) = NGLI_MAT4_IDENTITY;
     if (!ngli_darray_push(&s->modelview_matrix_stack, id_matrix) ||
@@ -607,6 +743,17 @@ int ngl_configure(struct ngl_ctx *s, struct ngl_config *config)
         return NGL_ERROR_INVALID_ARG;
     }
 
+    if (config->share_ctx) {
+        if (config->share_ctx == s) {
+            LOG(ERROR, "context cannot share resources with itself");
+            return NGL_ERROR_INVALID_ARG;
+        }
+        if (!config->share_ctx->configured) {
+            LOG(ERROR, "share context must be configured");
+            return NGL_ERROR_INVALID_USAGE;
+        }
+    }
+
     if (config->offscreen) {
         if (config->width <= 0 || config->height <= 0) {
             LOG(ERROR,
@@ -622,6 +769,8 @@ int ngl_configure(struct ngl_ctx *s, struct ngl_config *config)
         }
     }
 
+    ngl_wait(s);
+
     s->configured = 0;
 #if defined(TARGET_IPHONE) || defined(TARGET_DARWIN)
     int ret = configure_ios(s, config);
@@ -711,6 +860,71 @@ int ngl_draw(struct ngl_ctx *s, double t)
     return dispatch_cmd(s, cmd_draw, &t);
 }
 
+int ngl_draw_async(struct ngl_ctx *s, double t)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured before drawing");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    /*
+     * Queue the draw and return without waiting for its completion: the
+     * worker executes it while the caller is free to prepare the next frame.
+     * The status of the frame is returned by the matching ngl_wait().
+     */
+    pthread_mutex_lock(&s->lock);
+    if (s->async_pending) {
+        pthread_mutex_unlock(&s->lock);
+        LOG(ERROR, "the previous asynchronous draw must be waited with ngl_wait() first");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+    wait_cmd(s);
+    s->async_pending = 1;
+    s->async_draw_time = t;
+    s->cmd_func = cmd_draw;
+    s->cmd_arg = &s->async_draw_time;
+    s->cmd_async = 1;
+    pthread_cond_signal(&s->cond_wkr);
+    pthread_mutex_unlock(&s->lock);
+
+    return 0;
+}
+
+char *ngl_get_startup_profile(struct ngl_ctx *s)
+{
+    char *report = NULL;
+    int ret = dispatch_cmd(s, cmd_get_startup_profile, &report);
+    if (ret < 0)
+        return NULL;
+    return report;
+}
+
+char *ngl_get_shaders(struct ngl_ctx *s)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured before getting the shaders");
+        return NULL;
+    }
+
+    char *shaders = NULL;
+    int ret = dispatch_cmd(s, cmd_get_shaders, &shaders);
+    if (ret < 0)
+        return NULL;
+    return shaders;
+}
+
+int ngl_wait(struct ngl_ctx *s)
+{
+    pthread_mutex_lock(&s->lock);
+    wait_cmd(s);
+    const int ret = s->async_pending ? s->async_ret : 0;
+    s->async_pending = 0;
+    s->async_ret = 0;
+    pthread_mutex_unlock(&s->lock);
+
+    return ret;
+}
+
 void ngl_freep(struct ngl_ctx **ss)
 {
     struct ngl_ctx *s = *ss;
@@ -726,6 +940,9 @@ void ngl_freep(struct ngl_ctx **ss)
     ngli_darray_reset(&s->modelview_matrix_stack);
     ngli_darray_reset(&s->projection_matrix_stack);
     ngli_darray_reset(&s->activitycheck_nodes);
+    ngli_darray_reset(&s->eviction_candidates);
+    ngli_darray_reset(&s->hoist_reads);
+    ngli_profile_reset(&s->profile);
     ngli_freep(ss);
 }
 
@@ -91,6 +91,18 @@ static int get_gl_format_type(struct glcontext *gl, int data_format,
         [NGLI_FORMAT_D24_UNORM_S8_UINT]    = {GL_DEPTH_STENCIL,   GL_DEPTH24_STENCIL8,   GL_UNSIGNED_INT_24_8},
         [NGLI_FORMAT_D32_SFLOAT_S8_UINT]   = {GL_DEPTH_STENCIL,   GL_DEPTH32F_STENCIL8,  GL_FLOAT_32_UNSIGNED_INT_24_8_REV},
         [NGLI_FORMAT_S8_UINT]              = {GL_STENCIL_INDEX,   GL_STENCIL_INDEX8,     GL_UNSIGNED_BYTE},
+        [NGLI_FORMAT_BC1_RGBA_UNORM_BLOCK]      = {GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,        GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,        GL_UNSIGNED_BYTE},
+        [NGLI_FORMAT_BC1_RGBA_SRGB_BLOCK]       = {GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT,  GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT,  GL_UNSIGNED_BYTE},
+        [NGLI_FORMAT_BC3_UNORM_BLOCK]           = {GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,        GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,        GL_UNSIGNED_BYTE},
+        [NGLI_FORMAT_BC3_SRGB_BLOCK]            = {GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT,  GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT,  GL_UNSIGNED_BYTE},
+        [NGLI_FORMAT_BC7_UNORM_BLOCK]           = {GL_COMPRESSED_RGBA_BPTC_UNORM,           GL_COMPRESSED_RGBA_BPTC_UNORM,           GL_UNSIGNED_BYTE},
+        [NGLI_FORMAT_BC7_SRGB_BLOCK]            = {GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM,     GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM,     GL_UNSIGNED_BYTE},
+        [NGLI_FORMAT_ETC2_R8G8B8_UNORM_BLOCK]   = {GL_COMPRESSED_RGB8_ETC2,                 GL_COMPRESSED_RGB8_ETC2,                 GL_UNSIGNED_BYTE},
+        [NGLI_FORMAT_ETC2_R8G8B8_SRGB_BLOCK]    = {GL_COMPRESSED_SRGB8_ETC2,                GL_COMPRESSED_SRGB8_ETC2,                GL_UNSIGNED_BYTE},
+        [NGLI_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK] = {GL_COMPRESSED_RGBA8_ETC2_EAC,            GL_COMPRESSED_RGBA8_ETC2_EAC,            GL_UNSIGNED_BYTE},
+        [NGLI_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK]  = {GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC,     GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC,     GL_UNSIGNED_BYTE},
+        [NGLI_FORMAT_ASTC_4x4_UNORM_BLOCK]      = {GL_COMPRESSED_RGBA_ASTC_4x4_KHR,         GL_COMPRESSED_RGBA_ASTC_4x4_KHR,         GL_UNSIGNED_BYTE},
+        [NGLI_FORMAT_ASTC_4x4_SRGB_BLOCK]       = {GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR, GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR, GL_UNSIGNED_BYTE},
     };
 
     ngli_assert(data_format >= 0 && data_format < NGLI_ARRAY_NB(format_map));
@@ -142,3 +154,26 @@ int ngli_format_get_gl_renderbuffer_format(struct glcontext *gl, int data_format
 {
     return get_gl_format_type(gl, data_format, NULL, formatp, NULL);
 }
+
+int ngli_format_get_gl_vertex_attrib_format(struct glcontext *gl, int data_format,
+                                            GLenum *typep, GLboolean *normalizedp)
+{
+    GLint format;
+    GLenum type;
+
+    int ret = get_gl_format_type(gl, data_format, &format, NULL, &type);
+    if (ret < 0)
+        return ret;
+
+    const int integer = format == GL_RED_INTEGER || format == GL_RG_INTEGER ||
+                        format == GL_RGB_INTEGER || format == GL_RGBA_INTEGER ||
+                        format == GL_BGRA_INTEGER;
+    const int floating = type == GL_FLOAT || type == GL_HALF_FLOAT;
+
+    if (typep)
+        *typep = type;
+    if (normalizedp)
+        *normalizedp = !integer && !floating ? GL_TRUE : GL_FALSE;
+
+    return 0;
+}
@@ -420,6 +420,11 @@ static int gl_init(struct gctx *s)
     s_priv->default_rendertarget_desc.depth_stencil.resolve = gl->samples > 1;
 
     ngli_glstate_probe(gl, &s_priv->glstate);
+    if (gl->features & NGLI_FEATURE_PRIMITIVE_RESTART_FIXED_INDEX) {
+        GLboolean primitive_restart = GL_FALSE;
+        ngli_glGetBooleanv(gl, GL_PRIMITIVE_RESTART_FIXED_INDEX, &primitive_restart);
+        s_priv->primitive_restart = primitive_restart;
+    }
     s_priv->default_graphicstate = NGLI_GRAPHICSTATE_DEFAULTS;
 
     const int *viewport = config->viewport;
@@ -654,6 +659,24 @@ static int gl_query_draw_time(struct gctx *s, int64_t *time)
     return 0;
 }
 
+static void gl_wait_idle(struct gctx *s)
+{
+    struct gctx_gl *s_priv = (struct gctx_gl *)s;
+    ngli_glFinish(s_priv->glcontext);
+}
+
+static uintptr_t gl_get_display(struct gctx *s)
+{
+    struct gctx_gl *s_priv = (struct gctx_gl *)s;
+    return ngli_glcontext_get_display(s_priv->glcontext);
+}
+
+static uintptr_t gl_get_handle(struct gctx *s)
+{
+    struct gctx_gl *s_priv = (struct gctx_gl *)s;
+    return ngli_glcontext_get_handle(s_priv->glcontext);
+}
+
 static void gl_destroy(struct gctx *s)
 {
     struct gctx_gl *s_priv = (struct gctx_gl *)s;
@@ -790,6 +813,9 @@ const struct gctx_class ngli_gctx_gl = {
     .begin_draw   = gl_begin_draw,
     .end_draw     = gl_end_draw,
     .query_draw_time = gl_query_draw_time,
+    .wait_idle    = gl_wait_idle,
+    .get_display  = gl_get_display,
+    .get_handle   = gl_get_handle,
     .destroy      = gl_destroy,
 
     .transform_cull_mode              = gl_transform_cull_mode,
@@ -840,6 +866,7 @@ const struct gctx_class ngli_gctx_gl = {
     .texture_has_mipmap       = ngli_texture_gl_has_mipmap,
     .texture_match_dimensions = ngli_texture_gl_match_dimensions,
     .texture_upload           = ngli_texture_gl_upload,
+    .texture_upload_compressed = ngli_texture_gl_upload_compressed,
     .texture_generate_mipmap  = ngli_texture_gl_generate_mipmap,
     .texture_freep            = ngli_texture_gl_freep,
 };
@@ -853,6 +880,9 @@ const struct gctx_class ngli_gctx_gles = {
     .begin_draw   = gl_begin_draw,
     .end_draw     = gl_end_draw,
     .query_draw_time = gl_query_draw_time,
+    .wait_idle    = gl_wait_idle,
+    .get_display  = gl_get_display,
+    .get_handle   = gl_get_handle,
     .destroy      = gl_destroy,
 
     .transform_cull_mode              = gl_transform_cull_mode,
@@ -903,6 +933,7 @@ const struct gctx_class ngli_gctx_gles = {
     .texture_has_mipmap       = ngli_texture_gl_has_mipmap,
     .texture_match_dimensions = ngli_texture_gl_match_dimensions,
     .texture_upload           = ngli_texture_gl_upload,
+    .texture_upload_compressed = ngli_texture_gl_upload_compressed,
     .texture_generate_mipmap  = ngli_texture_gl_generate_mipmap,
     .texture_freep            = ngli_texture_gl_freep,
 };
@@ -50,6 +50,7 @@ struct gctx_gl {
     struct rendertarget *rendertarget;
     int viewport[4];
     int scissor[4];
+    int primitive_restart; // GL_PRIMITIVE_RESTART_FIXED_INDEX is enabled
     struct rendertarget *rt;
     /* Offscreen render target resources */
     struct texture *color;
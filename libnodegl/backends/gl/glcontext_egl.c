@@ -19,6 +19,7 @@
  * under the License.
  */
 
+#include <pthread.h>
 #include <stdio.h>
 #include <EGL/egl.h>
 #include <EGL/eglext.h>
@@ -43,6 +44,7 @@
 #include "format.h"
 #include "glcontext.h"
 #include "log.h"
+#include "memory.h"
 #include "nodegl.h"
 #include "utils.h"
 
@@ -50,11 +52,74 @@
 #define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
 #define EGL_PLATFORM_WAYLAND 0x31D8
 
+/*
+ * An EGL display is shared by all the contexts created on it (such as the
+ * contexts of a share group), which can be destroyed in any order: terminating
+ * it, and closing the X11 display opened for it, is left to the last one.
+ */
+struct display_ref {
+    EGLDisplay display;
+    EGLNativeDisplayType native_display;
+    int own_native_display;
+    int refcount;
+    struct display_ref *next;
+};
+
+static pthread_mutex_t display_refs_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct display_ref *display_refs;
+
+static struct display_ref *ref_display(EGLDisplay display, EGLNativeDisplayType native_display, int own_native_display)
+{
+    pthread_mutex_lock(&display_refs_lock);
+
+    struct display_ref *ref = display_refs;
+    while (ref && ref->display != display)
+        ref = ref->next;
+
+    if (!ref) {
+        ref = ngli_calloc(1, sizeof(*ref));
+        if (!ref)
+            goto end;
+        ref->display = display;
+        ref->native_display = native_display;
+        ref->own_native_display = own_native_display;
+        ref->next = display_refs;
+        display_refs = ref;
+    }
+    ref->refcount++;
+
+end:
+    pthread_mutex_unlock(&display_refs_lock);
+    return ref;
+}
+
+static void unref_display(struct display_ref *ref)
+{
+    pthread_mutex_lock(&display_refs_lock);
+
+    if (--ref->refcount == 0) {
+        struct display_ref **refp = &display_refs;
+        while (*refp != ref)
+            refp = &(*refp)->next;
+        *refp = ref->next;
+
+        eglTerminate(ref->display);
+#if defined(TARGET_LINUX)
+        if (ref->own_native_display)
+            XCloseDisplay(ref->native_display);
+#endif
+        ngli_free(ref);
+    }
+
+    pthread_mutex_unlock(&display_refs_lock);
+}
+
 struct egl_priv {
     EGLNativeDisplayType native_display;
     int own_native_display;
     EGLNativeWindowType native_window;
     EGLDisplay display;
+    struct display_ref *display_ref;
     EGLSurface surface;
     EGLContext handle;
     EGLConfig config;
@@ -249,6 +314,12 @@ static int egl_init(struct glcontext *ctx, uintptr_t display, uintptr_t window,
         return -1;
     }
 
+    /* the display (and the X11 display opened for it) is now owned by the reference */
+    egl->display_ref = ref_display(egl->display, egl->native_display, egl->own_native_display);
+    if (!egl->display_ref)
+        return -1;
+    egl->own_native_display = 0;
+
     egl->extensions = eglQueryString(egl->display, EGL_EXTENSIONS);
     if (!egl->extensions) {
         LOG(ERROR, "could not retrieve EGL extensions");
@@ -408,8 +479,9 @@ static void egl_uninit(struct glcontext *ctx)
     if (egl->handle)
         eglDestroyContext(egl->display, egl->handle);
 
-    if (egl->display)
-        eglTerminate(egl->display);
+    /* the display is terminated with its last context */
+    if (egl->display_ref)
+        unref_display(egl->display_ref);
 
 #if defined(TARGET_LINUX)
     if (ctx->platform == NGL_PLATFORM_XLIB) {
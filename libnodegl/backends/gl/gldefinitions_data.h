@@ -42,6 +42,7 @@ static const struct gldefinition {
     {"glClientWaitSync", offsetof(struct glfunctions, ClientWaitSync), 0},
     {"glColorMask", offsetof(struct glfunctions, ColorMask), M},
     {"glCompileShader", offsetof(struct glfunctions, CompileShader), M},
+    {"glCompressedTexSubImage2D", offsetof(struct glfunctions, CompressedTexSubImage2D), M},
     {"glCreateProgram", offsetof(struct glfunctions, CreateProgram), M},
     {"glCreateShader", offsetof(struct glfunctions, CreateShader), M},
     {"glCullFace", offsetof(struct glfunctions, CullFace), M},
@@ -287,5 +287,61 @@ static const struct glfeature {
         .version        = 300,
         .es_version     = 300,
         .es_extensions  = (const char*[]){"GL_EXT_shader_texture_lod", NULL},
+    }, {
+        .name           = "texture_compression_s3tc",
+        .flag           = NGLI_FEATURE_TEXTURE_COMPRESSION_S3TC,
+        .extensions     = (const char*[]){"GL_EXT_texture_compression_s3tc", NULL},
+        .es_extensions  = (const char*[]){"GL_EXT_texture_compression_s3tc", NULL},
+        .funcs_offsets  = (const size_t[]){OFFSET(CompressedTexSubImage2D),
+                                           -1}
+    }, {
+        .name           = "texture_compression_s3tc_srgb",
+        .flag           = NGLI_FEATURE_TEXTURE_COMPRESSION_S3TC_SRGB,
+        .extensions     = (const char*[]){"GL_EXT_texture_compression_s3tc", "GL_EXT_texture_sRGB", NULL},
+        .es_extensions  = (const char*[]){"GL_EXT_texture_compression_s3tc_srgb", NULL},
+        .funcs_offsets  = (const size_t[]){OFFSET(CompressedTexSubImage2D),
+                                           -1}
+    }, {
+        .name           = "texture_compression_bptc",
+        .flag           = NGLI_FEATURE_TEXTURE_COMPRESSION_BPTC,
+        .version        = 420,
+        .extensions     = (const char*[]){"GL_ARB_texture_compression_bptc", NULL},
+        .es_extensions  = (const char*[]){"GL_EXT_texture_compression_bptc", NULL},
+        .funcs_offsets  = (const size_t[]){OFFSET(CompressedTexSubImage2D),
+                                           -1}
+    }, {
+        .name           = "texture_compression_etc2",
+        .flag           = NGLI_FEATURE_TEXTURE_COMPRESSION_ETC2,
+        .version        = 430,
+        .es_version     = 300,
+        .extensions     = (const char*[]){"GL_ARB_ES3_compatibility", NULL},
+        .funcs_offsets  = (const size_t[]){OFFSET(CompressedTexSubImage2D),
+                                           -1}
+    }, {
+        .name           = "texture_compression_astc",
+        .flag           = NGLI_FEATURE_TEXTURE_COMPRESSION_ASTC,
+        .es_version     = 320,
+        .extensions     = (const char*[]){"GL_KHR_texture_compression_astc_ldr", NULL},
+        .es_extensions  = (const char*[]){"GL_KHR_texture_compression_astc_ldr", NULL},
+        .funcs_offsets  = (const size_t[]){OFFSET(CompressedTexSubImage2D),
+                                           -1}
+    }, {
+        .name           = "vertex_attrib_half_float",
+        .flag           = NGLI_FEATURE_VERTEX_ATTRIB_HALF_FLOAT,
+        .version        = 300,
+        .es_version     = 300,
+        .extensions     = (const char*[]){"GL_ARB_half_float_vertex", NULL},
+    }, {
+        .name           = "primitive_restart_fixed_index",
+        .flag           = NGLI_FEATURE_PRIMITIVE_RESTART_FIXED_INDEX,
+        .version        = 430,
+        .es_version     = 300,
+        .extensions     = (const char*[]){"GL_ARB_ES3_compatibility", NULL},
+    }, {
+        /* before, desktop GL decodes a signed normalized c as (2c+1)/(2^b-1) */
+        .name           = "snorm_symmetric_conversion",
+        .flag           = NGLI_FEATURE_SNORM_SYMMETRIC_CONVERSION,
+        .version        = 420,
+        .es_version     = 300,
     }
 };
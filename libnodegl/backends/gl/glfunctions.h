@@ -35,6 +35,7 @@ struct glfunctions {
     GLenum (NGLI_GL_APIENTRY *ClientWaitSync)(GLsync sync, GLbitfield flags, GLuint64 timeout);
     void (NGLI_GL_APIENTRY *ColorMask)(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha);
     void (NGLI_GL_APIENTRY *CompileShader)(GLuint shader);
+    void (NGLI_GL_APIENTRY *CompressedTexSubImage2D)(GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void * data);
     GLuint (NGLI_GL_APIENTRY *CreateProgram)();
     GLuint (NGLI_GL_APIENTRY *CreateShader)(GLenum type);
     void (NGLI_GL_APIENTRY *CullFace)(GLenum mode);
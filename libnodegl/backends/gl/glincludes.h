@@ -272,4 +272,35 @@ typedef void (NGLI_GL_APIENTRY *GLDEBUGPROC)(GLenum source, GLenum type, GLuint
 # define GL_ACTIVE_RESOURCES                   0x92F5
 #endif
 
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+# define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT       0x83F1
+# define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT       0x83F3
+#endif
+
+#ifndef GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT
+# define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT1_EXT 0x8C4D
+# define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+# define GL_COMPRESSED_RGBA_BPTC_UNORM          0x8E8C
+# define GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM    0x8E8D
+#endif
+
+#ifndef GL_COMPRESSED_RGB8_ETC2
+# define GL_COMPRESSED_RGB8_ETC2                0x9274
+# define GL_COMPRESSED_SRGB8_ETC2               0x9275
+# define GL_COMPRESSED_RGBA8_ETC2_EAC           0x9278
+# define GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC    0x9279
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+# define GL_COMPRESSED_RGBA_ASTC_4x4_KHR        0x93B0
+# define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4_KHR 0x93D0
+#endif
+
+#ifndef GL_PRIMITIVE_RESTART_FIXED_INDEX
+# define GL_PRIMITIVE_RESTART_FIXED_INDEX       0x8D69
+#endif
+
 #endif /* GLINCLUDES_H */
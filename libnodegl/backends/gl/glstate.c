@@ -328,3 +328,21 @@ void ngli_glstate_update_scissor(struct gctx *gctx, const int *scissor)
     memcpy(glstate->scissor, tmp, sizeof(glstate->scissor));
     ngli_glScissor(gl, tmp[0], tmp[1], tmp[2], tmp[3]);
 }
+
+/*
+ * Primitive restart is only enabled for the draws of the indices converted
+ * to strips, so the maximum index value of the other draws is not affected
+ */
+void ngli_glstate_update_primitive_restart(struct gctx *gctx, int primitive_restart)
+{
+    struct gctx_gl *gctx_gl = (struct gctx_gl *)gctx;
+    struct glcontext *gl = gctx_gl->glcontext;
+
+    if (gctx_gl->primitive_restart == primitive_restart)
+        return;
+    if (primitive_restart)
+        ngli_glEnable(gl, GL_PRIMITIVE_RESTART_FIXED_INDEX);
+    else
+        ngli_glDisable(gl, GL_PRIMITIVE_RESTART_FIXED_INDEX);
+    gctx_gl->primitive_restart = primitive_restart;
+}
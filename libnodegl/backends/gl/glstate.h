@@ -73,4 +73,7 @@ void ngli_glstate_use_program(struct gctx *gctx,
 void ngli_glstate_update_scissor(struct gctx *gctx,
                                  const int *scissor);
 
+void ngli_glstate_update_primitive_restart(struct gctx *gctx,
+                                           int primitive_restart);
+
 #endif
@@ -186,6 +186,12 @@ static inline void ngli_glCompileShader(const struct glcontext *gl, GLuint shade
     check_error_code(gl, "glCompileShader");
 }
 
+static inline void ngli_glCompressedTexSubImage2D(const struct glcontext *gl, GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLsizei imageSize, const void * data)
+{
+    gl->funcs.CompressedTexSubImage2D(target, level, xoffset, yoffset, width, height, format, imageSize, data);
+    check_error_code(gl, "glCompressedTexSubImage2D");
+}
+
 static inline GLuint ngli_glCreateProgram(const struct glcontext *gl)
 {
     GLuint ret = gl->funcs.CreateProgram();
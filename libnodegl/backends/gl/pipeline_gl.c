@@ -23,6 +23,7 @@
 
 #include "buffer_gl.h"
 #include "format.h"
+#include "format_gl.h"
 #include "gctx_gl.h"
 #include "glcontext.h"
 #include "log.h"
@@ -45,7 +46,7 @@ struct uniform_binding {
 
 struct texture_binding {
     struct pipeline_texture_desc desc;
-    const struct texture *texture;
+    struct texture *texture;
 };
 
 struct buffer_binding {
@@ -271,7 +272,7 @@ static void set_textures(struct pipeline *s, struct glcontext *gl)
     const struct texture_binding *bindings = ngli_darray_data(&s_priv->texture_bindings);
     for (int i = 0; i < ngli_darray_count(&s_priv->texture_bindings); i++) {
         const struct texture_binding *texture_binding = &bindings[i];
-        const struct texture *texture = texture_binding->texture;
+        struct texture *texture = texture_binding->texture;
         const struct texture_gl *texture_gl = (const struct texture_gl *)texture;
 
         if (texture_binding->desc.type == NGLI_TYPE_IMAGE_2D) {
@@ -290,6 +291,7 @@ static void set_textures(struct pipeline *s, struct glcontext *gl)
             ngli_glUniform1i(gl, texture_binding->desc.location, texture_index);
             ngli_glActiveTexture(gl, GL_TEXTURE0 + texture_index);
             if (texture) {
+                ngli_texture_update_mipmap(texture);
                 ngli_glBindTexture(gl, texture_gl->target, texture_gl->id);
             } else {
                 ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
@@ -354,6 +356,8 @@ static void set_vertex_attribs(const struct pipeline *s, struct glcontext *gl)
 {
     struct pipeline_gl *s_priv = (struct pipeline_gl *)s;
 
+    /* interleaved attributes share the same buffer which is only bound once */
+    GLuint bound_id = 0;
     const struct attribute_binding *bindings = ngli_darray_data(&s_priv->attribute_bindings);
     for (int i = 0; i < ngli_darray_count(&s_priv->attribute_bindings); i++) {
         const struct attribute_binding *attribute_binding = &bindings[i];
@@ -362,14 +366,20 @@ static void set_vertex_attribs(const struct pipeline *s, struct glcontext *gl)
         const GLuint location = attribute_binding->desc.location;
         const GLuint size = ngli_format_get_nb_comp(attribute_binding->desc.format);
         const GLint stride = attribute_binding->desc.stride;
+        GLenum type = GL_FLOAT;
+        GLboolean normalized = GL_FALSE;
+        ngli_format_get_gl_vertex_attrib_format(gl, attribute_binding->desc.format, &type, &normalized);
 
         ngli_glEnableVertexAttribArray(gl, location);
         if ((gl->features & NGLI_FEATURE_INSTANCED_ARRAY) && attribute_binding->desc.rate > 0)
             ngli_glVertexAttribDivisor(gl, location, attribute_binding->desc.rate);
 
         if (buffer_gl) {
-            ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, buffer_gl->id);
-            ngli_glVertexAttribPointer(gl, location, size, GL_FLOAT, GL_FALSE, stride, (void*)(uintptr_t)(attribute_binding->desc.offset));
+            if (buffer_gl->id != bound_id) {
+                ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, buffer_gl->id);
+                bound_id = buffer_gl->id;
+            }
+            ngli_glVertexAttribPointer(gl, location, size, type, normalized, stride, (void*)(uintptr_t)(attribute_binding->desc.offset));
         }
     }
 }
@@ -606,10 +616,13 @@ int ngli_pipeline_gl_update_attribute(struct pipeline *s, int index, struct buff
         const GLuint location = attribute_binding->desc.location;
         const GLuint size = ngli_format_get_nb_comp(attribute_binding->desc.format);
         const GLint stride = attribute_binding->desc.stride;
+        GLenum type = GL_FLOAT;
+        GLboolean normalized = GL_FALSE;
+        ngli_format_get_gl_vertex_attrib_format(gl, attribute_binding->desc.format, &type, &normalized);
         struct buffer_gl *buffer_gl = (struct buffer_gl *)buffer;
         ngli_glBindVertexArray(gl, s_priv->vao_id);
         ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, buffer_gl->id);
-        ngli_glVertexAttribPointer(gl, location, size, GL_FLOAT, GL_FALSE, stride, (void*)(uintptr_t)(attribute_binding->desc.offset));
+        ngli_glVertexAttribPointer(gl, location, size, type, normalized, stride, (void*)(uintptr_t)(attribute_binding->desc.offset));
     }
 
     return 0;
@@ -745,6 +758,8 @@ void ngli_pipeline_gl_draw_indexed(struct pipeline *s, struct buffer *indices, i
     const struct buffer_gl *indices_gl = (const struct buffer_gl *)indices;
     const GLenum gl_indices_type = get_gl_indices_type(indices_format);
     ngli_glBindBuffer(gl, GL_ELEMENT_ARRAY_BUFFER, indices_gl->id);
+    if (gl->features & NGLI_FEATURE_PRIMITIVE_RESTART_FIXED_INDEX)
+        ngli_glstate_update_primitive_restart(gctx, graphics->primitive_restart);
 
     const GLenum gl_topology = ngli_topology_get_gl_topology(graphics->topology);
     if (nb_instances > 1)
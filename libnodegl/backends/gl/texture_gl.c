@@ -196,7 +196,9 @@ static void texture_set_storage(struct texture *s)
     switch (s_priv->target) {
     case GL_TEXTURE_2D: {
         int mipmap_levels = 1;
-        if (ngli_texture_gl_has_mipmap(s))
+        if (params->nb_levels)
+            mipmap_levels = params->nb_levels;
+        else if (ngli_texture_gl_has_mipmap(s))
             while ((params->width | params->height) >> mipmap_levels)
                 mipmap_levels += 1;
         ngli_glTexStorage2D(gl, s_priv->target, mipmap_levels, s_priv->internal_format, params->width, params->height);
@@ -362,6 +364,11 @@ int ngli_texture_gl_init(struct texture *s, const struct texture_params *params)
                     params->width, params->height, params->depth);
                 return NGL_ERROR_INVALID_ARG;
             }
+            if (ngli_format_is_compressed(params->format) &&
+                (!params->immutable || s_priv->target != GL_TEXTURE_2D)) {
+                LOG(ERROR, "compressed formats are only supported with immutable 2D textures");
+                return NGL_ERROR_UNSUPPORTED;
+            }
             if (params->immutable) {
                 texture_set_storage(s);
             } else {
@@ -437,14 +444,43 @@ int ngli_texture_gl_upload(struct texture *s, const uint8_t *data, int linesize)
     ngli_glBindTexture(gl, s_priv->target, s_priv->id);
     if (data) {
         texture_set_sub_image(s, data, linesize);
-        if (ngli_texture_gl_has_mipmap(s))
-            ngli_glGenerateMipmap(gl, s_priv->target);
+        ngli_texture_invalidate_mipmap(s);
     }
     ngli_glBindTexture(gl, s_priv->target, 0);
 
     return 0;
 }
 
+int ngli_texture_gl_upload_compressed(struct texture *s, int level, const uint8_t *data, int size)
+{
+    struct texture_gl *s_priv = (struct texture_gl *)s;
+    struct gctx_gl *gctx_gl = (struct gctx_gl *)s->gctx;
+    struct glcontext *gl = gctx_gl->glcontext;
+    const struct texture_params *params = &s->params;
+
+    ngli_assert(!s->external_storage);
+    ngli_assert(params->usage & NGLI_TEXTURE_USAGE_TRANSFER_DST_BIT);
+    ngli_assert(s_priv->target == GL_TEXTURE_2D);
+    ngli_assert(ngli_format_is_compressed(params->format));
+
+    const int width  = NGLI_MAX(params->width  >> level, 1);
+    const int height = NGLI_MAX(params->height >> level, 1);
+    if (size != ngli_format_get_image_size(params->format, width, height)) {
+        LOG(ERROR, "compressed level %d size (%d) does not match its dimensions (%dx%d)",
+            level, size, width, height);
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    /* Compressed levels are provided as is: they are never regenerated from
+     * the base level since GL can not generate mipmaps for these formats */
+    ngli_glBindTexture(gl, s_priv->target, s_priv->id);
+    ngli_glCompressedTexSubImage2D(gl, s_priv->target, level, 0, 0, width, height,
+                                   s_priv->internal_format, size, data);
+    ngli_glBindTexture(gl, s_priv->target, 0);
+
+    return 0;
+}
+
 int ngli_texture_gl_generate_mipmap(struct texture *s)
 {
     struct texture_gl *s_priv = (struct texture_gl *)s;
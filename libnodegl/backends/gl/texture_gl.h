@@ -54,6 +54,7 @@ int ngli_texture_gl_has_mipmap(const struct texture *s);
 int ngli_texture_gl_match_dimensions(const struct texture *s, int width, int height, int depth);
 
 int ngli_texture_gl_upload(struct texture *s, const uint8_t *data, int linesize);
+int ngli_texture_gl_upload_compressed(struct texture *s, int level, const uint8_t *data, int size);
 int ngli_texture_gl_generate_mipmap(struct texture *s);
 
 void ngli_texture_gl_freep(struct texture **sp);
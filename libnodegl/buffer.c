@@ -31,17 +31,39 @@ struct buffer *ngli_buffer_create(struct gctx *gctx)
 
 int ngli_buffer_init(struct buffer *s, int size, int usage)
 {
-    return s->gctx->class->buffer_init(s, size, usage);
+    int ret = s->gctx->class->buffer_init(s, size, usage);
+    if (ret < 0)
+        return ret;
+    ngli_buffer_uncharge(s);
+    s->memory_size = size;
+    s->memory_gctx = s->gctx;
+    s->memory_gctx->memory_usage += s->memory_size;
+    return 0;
 }
 
-int ngli_buffer_upload(struct buffer *s, const void *data, int size)
+int ngli_buffer_upload(struct buffer *s, const void *data, int size, int offset)
 {
-    return s->gctx->class->buffer_upload(s, data, size);
+    return s->gctx->class->buffer_upload(s, data, size, offset);
+}
+
+/*
+ * Remove the buffer from the memory usage of the context it is charged to.
+ * Besides its release, this is used when a context configured with a
+ * share_ctx hands the buffer over to the share group: it can then be released
+ * by another context, and outlive the one it was charged to.
+ */
+void ngli_buffer_uncharge(struct buffer *s)
+{
+    if (!s->memory_gctx)
+        return;
+    s->memory_gctx->memory_usage -= s->memory_size;
+    s->memory_gctx = NULL;
 }
 
 void ngli_buffer_freep(struct buffer **sp)
 {
     if (!*sp)
         return;
+    ngli_buffer_uncharge(*sp);
     (*sp)->gctx->class->buffer_freep(sp);
 }
@@ -22,6 +22,8 @@
 #ifndef BUFFER_H
 #define BUFFER_H
 
+#include <stdint.h>
+
 struct gctx;
 
 enum {
@@ -39,11 +41,14 @@ struct buffer {
     struct gctx *gctx;
     int size;
     int usage;
+    int64_t memory_size;       // size accounted in the memory usage of memory_gctx
+    struct gctx *memory_gctx;  // context charged with the memory of the buffer, if any
 };
 
 struct buffer *ngli_buffer_create(struct gctx *gctx);
 int ngli_buffer_init(struct buffer *s, int size, int usage);
-int ngli_buffer_upload(struct buffer *s, const void *data, int size);
+int ngli_buffer_upload(struct buffer *s, const void *data, int size, int offset);
+void ngli_buffer_uncharge(struct buffer *s);
 void ngli_buffer_freep(struct buffer **sp);
 
 #endif
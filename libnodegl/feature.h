@@ -58,6 +58,14 @@
 #define NGLI_FEATURE_SHADER_IMAGE_SIZE            (1ULL << 33)
 #define NGLI_FEATURE_SHADING_LANGUAGE_420PACK     (1ULL << 34)
 #define NGLI_FEATURE_SHADER_TEXTURE_LOD           (1ULL << 35)
+#define NGLI_FEATURE_TEXTURE_COMPRESSION_S3TC     (1ULL << 36)
+#define NGLI_FEATURE_TEXTURE_COMPRESSION_BPTC     (1ULL << 37)
+#define NGLI_FEATURE_TEXTURE_COMPRESSION_ETC2     (1ULL << 38)
+#define NGLI_FEATURE_TEXTURE_COMPRESSION_ASTC     (1ULL << 39)
+#define NGLI_FEATURE_VERTEX_ATTRIB_HALF_FLOAT     (1ULL << 40)
+#define NGLI_FEATURE_PRIMITIVE_RESTART_FIXED_INDEX (1ULL << 41)
+#define NGLI_FEATURE_SNORM_SYMMETRIC_CONVERSION   (1ULL << 42)
+#define NGLI_FEATURE_TEXTURE_COMPRESSION_S3TC_SRGB (1ULL << 43)
 
 #define NGLI_FEATURE_COMPUTE_SHADER_ALL (NGLI_FEATURE_COMPUTE_SHADER           | \
                                          NGLI_FEATURE_PROGRAM_INTERFACE_QUERY  | \
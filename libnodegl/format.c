@@ -86,6 +86,18 @@ static const struct {
     [NGLI_FORMAT_D24_UNORM_S8_UINT]   = {2, 3 + 1},
     [NGLI_FORMAT_D32_SFLOAT_S8_UINT]  = {3, 4 + 1 + 3},
     [NGLI_FORMAT_S8_UINT]             = {1, 1},
+    [NGLI_FORMAT_BC1_RGBA_UNORM_BLOCK]        = {4, 0},
+    [NGLI_FORMAT_BC1_RGBA_SRGB_BLOCK]         = {4, 0},
+    [NGLI_FORMAT_BC3_UNORM_BLOCK]             = {4, 0},
+    [NGLI_FORMAT_BC3_SRGB_BLOCK]              = {4, 0},
+    [NGLI_FORMAT_BC7_UNORM_BLOCK]             = {4, 0},
+    [NGLI_FORMAT_BC7_SRGB_BLOCK]              = {4, 0},
+    [NGLI_FORMAT_ETC2_R8G8B8_UNORM_BLOCK]     = {3, 0},
+    [NGLI_FORMAT_ETC2_R8G8B8_SRGB_BLOCK]      = {3, 0},
+    [NGLI_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK]   = {4, 0},
+    [NGLI_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK]    = {4, 0},
+    [NGLI_FORMAT_ASTC_4x4_UNORM_BLOCK]        = {4, 0},
+    [NGLI_FORMAT_ASTC_4x4_SRGB_BLOCK]         = {4, 0},
 };
 
 int ngli_format_get_bytes_per_pixel(int format)
@@ -124,3 +136,38 @@ int ngli_format_has_stencil(int format)
         return 0;
     }
 }
+
+int ngli_format_is_compressed(int format)
+{
+    return ngli_format_get_block_size(format) > 0;
+}
+
+int ngli_format_get_block_size(int format)
+{
+    switch (format) {
+    case NGLI_FORMAT_BC1_RGBA_UNORM_BLOCK:
+    case NGLI_FORMAT_BC1_RGBA_SRGB_BLOCK:
+    case NGLI_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+    case NGLI_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+        return 8;
+    case NGLI_FORMAT_BC3_UNORM_BLOCK:
+    case NGLI_FORMAT_BC3_SRGB_BLOCK:
+    case NGLI_FORMAT_BC7_UNORM_BLOCK:
+    case NGLI_FORMAT_BC7_SRGB_BLOCK:
+    case NGLI_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+    case NGLI_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+    case NGLI_FORMAT_ASTC_4x4_UNORM_BLOCK:
+    case NGLI_FORMAT_ASTC_4x4_SRGB_BLOCK:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+int64_t ngli_format_get_image_size(int format, int width, int height)
+{
+    const int block_size = ngli_format_get_block_size(format);
+    if (block_size)
+        return (int64_t)((width + 3) / 4) * ((height + 3) / 4) * block_size;
+    return (int64_t)width * height * ngli_format_get_bytes_per_pixel(format);
+}
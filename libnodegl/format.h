@@ -22,6 +22,8 @@
 #ifndef FORMAT_H
 #define FORMAT_H
 
+#include <stdint.h>
+
 enum {
     NGLI_FORMAT_UNDEFINED,
     NGLI_FORMAT_R8_UNORM,
@@ -85,6 +87,18 @@ enum {
     NGLI_FORMAT_D24_UNORM_S8_UINT,
     NGLI_FORMAT_D32_SFLOAT_S8_UINT,
     NGLI_FORMAT_S8_UINT,
+    NGLI_FORMAT_BC1_RGBA_UNORM_BLOCK,
+    NGLI_FORMAT_BC1_RGBA_SRGB_BLOCK,
+    NGLI_FORMAT_BC3_UNORM_BLOCK,
+    NGLI_FORMAT_BC3_SRGB_BLOCK,
+    NGLI_FORMAT_BC7_UNORM_BLOCK,
+    NGLI_FORMAT_BC7_SRGB_BLOCK,
+    NGLI_FORMAT_ETC2_R8G8B8_UNORM_BLOCK,
+    NGLI_FORMAT_ETC2_R8G8B8_SRGB_BLOCK,
+    NGLI_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK,
+    NGLI_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK,
+    NGLI_FORMAT_ASTC_4x4_UNORM_BLOCK,
+    NGLI_FORMAT_ASTC_4x4_SRGB_BLOCK,
     NGLI_FORMAT_NB
 };
 
@@ -96,4 +110,14 @@ int ngli_format_has_depth(int format);
 
 int ngli_format_has_stencil(int format);
 
+/*
+ * Block compressed formats: bytes per pixel is not defined for them, the
+ * storage is expressed in blocks of 4x4 texels instead.
+ */
+int ngli_format_is_compressed(int format);
+
+int ngli_format_get_block_size(int format);
+
+int64_t ngli_format_get_image_size(int format, int width, int height);
+
 #endif
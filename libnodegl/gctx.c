@@ -102,6 +102,21 @@ int ngli_gctx_query_draw_time(struct gctx *s, int64_t *time)
     return s->class->query_draw_time(s, time);
 }
 
+void ngli_gctx_wait_idle(struct gctx *s)
+{
+    s->class->wait_idle(s);
+}
+
+uintptr_t ngli_gctx_get_display(struct gctx *s)
+{
+    return s->class->get_display(s);
+}
+
+uintptr_t ngli_gctx_get_handle(struct gctx *s)
+{
+    return s->class->get_handle(s);
+}
+
 void ngli_gctx_freep(struct gctx **sp)
 {
     if (!*sp)
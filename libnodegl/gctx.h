@@ -42,6 +42,9 @@ struct gctx_class {
     int (*begin_draw)(struct gctx *s, double t);
     int (*end_draw)(struct gctx *s, double t);
     int (*query_draw_time)(struct gctx *s, int64_t *time);
+    void (*wait_idle)(struct gctx *s);
+    uintptr_t (*get_display)(struct gctx *s);
+    uintptr_t (*get_handle)(struct gctx *s);
     void (*destroy)(struct gctx *s);
 
     int (*transform_cull_mode)(struct gctx *s, int cull_mode);
@@ -63,7 +66,7 @@ struct gctx_class {
 
     struct buffer *(*buffer_create)(struct gctx *ctx);
     int (*buffer_init)(struct buffer *s, int size, int usage);
-    int (*buffer_upload)(struct buffer *s, const void *data, int size);
+    int (*buffer_upload)(struct buffer *s, const void *data, int size, int offset);
     void (*buffer_freep)(struct buffer **sp);
 
     struct pipeline *(*pipeline_create)(struct gctx *ctx);
@@ -92,6 +95,7 @@ struct gctx_class {
     int (*texture_has_mipmap)(const struct texture *s);
     int (*texture_match_dimensions)(const struct texture *s, int width, int height, int depth);
     int (*texture_upload)(struct texture *s, const uint8_t *data, int linesize);
+    int (*texture_upload_compressed)(struct texture *s, int level, const uint8_t *data, int size);
     int (*texture_generate_mipmap)(struct texture *s);
     void (*texture_freep)(struct texture **sp);
 };
@@ -104,6 +108,7 @@ struct gctx {
     int language_version;
     uint64_t features;
     struct limits limits;
+    int64_t memory_usage; // bytes currently allocated by the textures and buffers
 };
 
 struct gctx *ngli_gctx_create(const struct ngl_config *config);
@@ -113,6 +118,9 @@ int ngli_gctx_set_capture_buffer(struct gctx *s, void *capture_buffer);
 int ngli_gctx_begin_draw(struct gctx *s, double t);
 int ngli_gctx_query_draw_time(struct gctx *s, int64_t *time);
 int ngli_gctx_end_draw(struct gctx *s, double t);
+void ngli_gctx_wait_idle(struct gctx *s);
+uintptr_t ngli_gctx_get_display(struct gctx *s);
+uintptr_t ngli_gctx_get_handle(struct gctx *s);
 void ngli_gctx_freep(struct gctx **sp);
 
 int ngli_gctx_transform_cull_mode(struct gctx *s, int cull_mode);
@@ -164,6 +164,7 @@ cmds = [
     # Texture
     'glActiveTexture',
     'glBindTexture',
+    'glCompressedTexSubImage2D',
     'glDeleteTextures',
     'glGenTextures',
     'glGenerateMipmap',
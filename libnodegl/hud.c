@@ -88,6 +88,7 @@ enum {
     MEMORY_BUFFERS_GPU,
     MEMORY_BLOCKS_CPU,
     MEMORY_BLOCKS_GPU,
+    MEMORY_BLOCKS_UPLOAD,
     MEMORY_TEXTURES,
     NB_MEMORY
 };
@@ -179,6 +180,11 @@ static const struct {
         .node_types=(const int[]){NGL_NODE_BLOCK, -1},
         .color=0xD6FF32FF,
     },
+    [MEMORY_BLOCKS_UPLOAD] = {
+        .label="Blocks upld",
+        .node_types=(const int[]){NGL_NODE_BLOCK, -1},
+        .color=0x32D6FFFF,
+    },
     [MEMORY_TEXTURES] = {
         .label="Textures",
         .node_types=(const int[]){NGL_NODE_TEXTURE2D, NGL_NODE_TEXTURE3D, -1},
@@ -473,6 +479,9 @@ static void widget_memory_make_stats(struct hud *s, struct widget *widget)
         priv->sizes[MEMORY_BLOCKS_GPU] += block->data_size * (block->buffer_refcount > 0);
     }
 
+    /* Amount of block data uploaded during the last frame */
+    priv->sizes[MEMORY_BLOCKS_UPLOAD] = s->ctx->block_upload_size;
+
     struct darray *nodes_tex_array = &priv->nodes[MEMORY_TEXTURES];
     struct ngl_node **nodes_tex = ngli_darray_data(nodes_tex_array);
     priv->sizes[MEMORY_TEXTURES] = 0;
@@ -1212,7 +1221,7 @@ int ngli_hud_init(struct hud *s)
     if (ret < 0)
         return ret;
 
-    ret = ngli_buffer_upload(s->coords, coords, sizeof(coords));
+    ret = ngli_buffer_upload(s->coords, coords, sizeof(coords), 0);
     if (ret < 0)
         return ret;
 
@@ -1346,7 +1355,7 @@ void ngli_hud_draw(struct hud *s)
          x,     1.0f, 1.0f, 0.0f,
     };
 
-    int ret = ngli_buffer_upload(s->coords, coords, sizeof(coords));
+    int ret = ngli_buffer_upload(s->coords, coords, sizeof(coords), 0);
     if (ret < 0)
         return;
 
@@ -24,8 +24,10 @@
 #include "buffer.h"
 #include "hwconv.h"
 #include "gctx.h"
+#include "hmap.h"
 #include "image.h"
 #include "log.h"
+#include "memory.h"
 #include "nodes.h"
 #include "pgcraft.h"
 #include "pipeline.h"
@@ -51,50 +53,30 @@ static const struct pgcraft_iovar vert_out_vars[] = {
     {.name = "var_tex_coord", .type = NGLI_TYPE_VEC2},
 };
 
-int ngli_hwconv_init(struct hwconv *hwconv, struct ngl_ctx *ctx,
-                     const struct image *dst_image,
-                     const struct image_params *src_params)
-{
-    struct gctx *gctx = ctx->gctx;
-    hwconv->ctx = ctx;
-    hwconv->src_params = *src_params;
-
-    if (dst_image->params.layout != NGLI_IMAGE_LAYOUT_DEFAULT) {
-        LOG(ERROR, "unsupported output image layout: 0x%x", dst_image->params.layout);
-        return NGL_ERROR_UNSUPPORTED;
-    }
-
-    struct texture *texture = dst_image->planes[0];
-    struct texture_params *texture_params = &texture->params;
+/*
+ * The conversion pipelines do not depend on the destination texture, only on
+ * the source image layout and the destination format: they are shared by all
+ * the hwconv instances of the context and refcounted.
+ */
+struct hwconv_pipeline {
+    int refcount;
+    struct buffer *vertices;
+    struct pgcraft *crafter;
+    struct pipeline *pipeline;
+};
 
-    struct rendertarget_desc rt_desc = {
-        .nb_colors = 1,
-        .colors[0].format = texture_params->format,
-    };
-    struct rendertarget_params rt_params = {
-        .width = dst_image->params.width,
-        .height = dst_image->params.height,
-        .nb_colors = 1,
-        .colors[0] = {
-            .attachment = texture,
-            .load_op    = NGLI_LOAD_OP_CLEAR,
-            .store_op   = NGLI_STORE_OP_STORE,
-        }
-    };
-    hwconv->rt = ngli_rendertarget_create(gctx);
-    if (!hwconv->rt)
-        return NGL_ERROR_MEMORY;
-    int ret = ngli_rendertarget_init(hwconv->rt, &rt_params);
-    if (ret < 0)
-        return ret;
+static void free_hwconv_pipeline(void *user_arg, void *data)
+{
+    struct hwconv_pipeline *s = data;
+    ngli_pipeline_freep(&s->pipeline);
+    ngli_pgcraft_freep(&s->crafter);
+    ngli_buffer_freep(&s->vertices);
+    ngli_free(s);
+}
 
-    enum image_layout src_layout = src_params->layout;
-    if (src_layout != NGLI_IMAGE_LAYOUT_NV12 &&
-        src_layout != NGLI_IMAGE_LAYOUT_NV12_RECTANGLE &&
-        src_layout != NGLI_IMAGE_LAYOUT_MEDIACODEC) {
-        LOG(ERROR, "unsupported texture layout: 0x%x", src_layout);
-        return NGL_ERROR_UNSUPPORTED;
-    }
+static int init_hwconv_pipeline(struct hwconv_pipeline *s, struct ngl_ctx *ctx, int format)
+{
+    struct gctx *gctx = ctx->gctx;
 
     static const float vertices[] = {
         -1.0f, -1.0f, 0.0f, 0.0f,
@@ -102,20 +84,21 @@ int ngli_hwconv_init(struct hwconv *hwconv, struct ngl_ctx *ctx,
         -1.0f,  1.0f, 0.0f, 1.0f,
          1.0f,  1.0f, 1.0f, 1.0f,
     };
-    hwconv->vertices = ngli_buffer_create(gctx);
-    if (!hwconv->vertices)
+    s->vertices = ngli_buffer_create(gctx);
+    if (!s->vertices)
         return NGL_ERROR_MEMORY;
-    ret = ngli_buffer_init(hwconv->vertices, sizeof(vertices), NGLI_BUFFER_USAGE_TRANSFER_DST_BIT |
-                                                               NGLI_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+    int ret = ngli_buffer_init(s->vertices, sizeof(vertices), NGLI_BUFFER_USAGE_TRANSFER_DST_BIT |
+                                                              NGLI_BUFFER_USAGE_VERTEX_BUFFER_BIT);
     if (ret < 0)
         return ret;
 
-    ret = ngli_buffer_upload(hwconv->vertices, vertices, sizeof(vertices));
+    ret = ngli_buffer_upload(s->vertices, vertices, sizeof(vertices), 0);
     if (ret < 0)
         return ret;
 
+    /* the source planes are bound at each conversion */
     struct pgcraft_texture textures[] = {
-        {.name = "tex", .type = NGLI_PGCRAFT_SHADER_TEX_TYPE_TEXTURE2D, .stage = NGLI_PROGRAM_SHADER_FRAG, .texture = texture},
+        {.name = "tex", .type = NGLI_PGCRAFT_SHADER_TEX_TYPE_TEXTURE2D, .stage = NGLI_PROGRAM_SHADER_FRAG},
     };
 
     const struct pgcraft_attribute attributes[] = {
@@ -124,7 +107,7 @@ int ngli_hwconv_init(struct hwconv *hwconv, struct ngl_ctx *ctx,
             .type     = NGLI_TYPE_VEC4,
             .format   = NGLI_FORMAT_R32G32B32A32_SFLOAT,
             .stride   = 4 * 4,
-            .buffer   = hwconv->vertices,
+            .buffer   = s->vertices,
         },
     };
 
@@ -133,7 +116,10 @@ int ngli_hwconv_init(struct hwconv *hwconv, struct ngl_ctx *ctx,
         .graphics      = {
             .topology    = NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP,
             .state       = NGLI_GRAPHICSTATE_DEFAULTS,
-            .rt_desc     = rt_desc,
+            .rt_desc     = {
+                .nb_colors = 1,
+                .colors[0].format = format,
+            },
         },
     };
 
@@ -148,48 +134,165 @@ int ngli_hwconv_init(struct hwconv *hwconv, struct ngl_ctx *ctx,
         .nb_vert_out_vars = NGLI_ARRAY_NB(vert_out_vars),
     };
 
-    hwconv->crafter = ngli_pgcraft_create(ctx);
-    if (!hwconv->crafter)
+    s->crafter = ngli_pgcraft_create(ctx);
+    if (!s->crafter)
         return NGL_ERROR_MEMORY;
 
     struct pipeline_resource_params pipeline_resource_params = {0};
-    ret = ngli_pgcraft_craft(hwconv->crafter, &pipeline_params, &pipeline_resource_params, &crafter_params);
+    ret = ngli_pgcraft_craft(s->crafter, &pipeline_params, &pipeline_resource_params, &crafter_params);
     if (ret < 0)
         return ret;
 
-    hwconv->pipeline = ngli_pipeline_create(gctx);
-    if (!hwconv->pipeline)
+    s->pipeline = ngli_pipeline_create(gctx);
+    if (!s->pipeline)
         return NGL_ERROR_MEMORY;
 
-    ret = ngli_pipeline_init(hwconv->pipeline, &pipeline_params);
+    ret = ngli_pipeline_init(s->pipeline, &pipeline_params);
     if (ret < 0)
         return ret;
 
-    ret = ngli_pipeline_set_resources(hwconv->pipeline, &pipeline_resource_params);
+    ret = ngli_pipeline_set_resources(s->pipeline, &pipeline_resource_params);
     if (ret < 0)
         return ret;
 
     return 0;
 }
 
+static int ref_hwconv_pipeline(struct hwconv *hwconv, enum image_layout layout, int format)
+{
+    struct ngl_ctx *ctx = hwconv->ctx;
+
+    char *key = ngli_asprintf("%d/%d", layout, format);
+    if (!key)
+        return NGL_ERROR_MEMORY;
+
+    struct hwconv_pipeline *s = ctx->hwconv_pipelines ? ngli_hmap_get(ctx->hwconv_pipelines, key) : NULL;
+    if (s) {
+        s->refcount++;
+        hwconv->pipeline_key = key;
+        hwconv->pipeline = s;
+        return 0;
+    }
+
+    if (!ctx->hwconv_pipelines) {
+        ctx->hwconv_pipelines = ngli_hmap_create();
+        if (!ctx->hwconv_pipelines) {
+            ngli_free(key);
+            return NGL_ERROR_MEMORY;
+        }
+        ngli_hmap_set_free(ctx->hwconv_pipelines, free_hwconv_pipeline, NULL);
+    }
+
+    s = ngli_calloc(1, sizeof(*s));
+    if (!s) {
+        ngli_free(key);
+        return NGL_ERROR_MEMORY;
+    }
+
+    int ret = init_hwconv_pipeline(s, ctx, format);
+    if (ret < 0) {
+        free_hwconv_pipeline(NULL, s);
+        ngli_free(key);
+        return ret;
+    }
+
+    ret = ngli_hmap_set(ctx->hwconv_pipelines, key, s);
+    if (ret < 0) {
+        free_hwconv_pipeline(NULL, s);
+        ngli_free(key);
+        return ret;
+    }
+
+    s->refcount = 1;
+    hwconv->pipeline_key = key;
+    hwconv->pipeline = s;
+    return 0;
+}
+
+static void unref_hwconv_pipeline(struct hwconv *hwconv)
+{
+    struct ngl_ctx *ctx = hwconv->ctx;
+    struct hwconv_pipeline *s = hwconv->pipeline;
+    if (!s)
+        return;
+
+    if (--s->refcount == 0) {
+        ngli_hmap_set(ctx->hwconv_pipelines, hwconv->pipeline_key, NULL);
+        if (!ngli_hmap_count(ctx->hwconv_pipelines))
+            ngli_hmap_freep(&ctx->hwconv_pipelines);
+    }
+    hwconv->pipeline = NULL;
+    ngli_freep(&hwconv->pipeline_key);
+}
+
+int ngli_hwconv_init(struct hwconv *hwconv, struct ngl_ctx *ctx,
+                     const struct image *dst_image,
+                     const struct image_params *src_params)
+{
+    struct gctx *gctx = ctx->gctx;
+    hwconv->ctx = ctx;
+    hwconv->src_params = *src_params;
+
+    if (dst_image->params.layout != NGLI_IMAGE_LAYOUT_DEFAULT) {
+        LOG(ERROR, "unsupported output image layout: 0x%x", dst_image->params.layout);
+        return NGL_ERROR_UNSUPPORTED;
+    }
+
+    struct texture *texture = dst_image->planes[0];
+    struct texture_params *texture_params = &texture->params;
+
+    struct rendertarget_params rt_params = {
+        .width = dst_image->params.width,
+        .height = dst_image->params.height,
+        .nb_colors = 1,
+        .colors[0] = {
+            .attachment = texture,
+            .load_op    = NGLI_LOAD_OP_CLEAR,
+            .store_op   = NGLI_STORE_OP_STORE,
+        }
+    };
+    hwconv->rt = ngli_rendertarget_create(gctx);
+    if (!hwconv->rt)
+        return NGL_ERROR_MEMORY;
+    int ret = ngli_rendertarget_init(hwconv->rt, &rt_params);
+    if (ret < 0)
+        return ret;
+
+    enum image_layout src_layout = src_params->layout;
+    if (src_layout != NGLI_IMAGE_LAYOUT_NV12 &&
+        src_layout != NGLI_IMAGE_LAYOUT_NV12_RECTANGLE &&
+        src_layout != NGLI_IMAGE_LAYOUT_MEDIACODEC) {
+        LOG(ERROR, "unsupported texture layout: 0x%x", src_layout);
+        return NGL_ERROR_UNSUPPORTED;
+    }
+
+    return ref_hwconv_pipeline(hwconv, src_layout, texture_params->format);
+}
+
 int ngli_hwconv_convert_image(struct hwconv *hwconv, const struct image *image)
 {
     struct ngl_ctx *ctx = hwconv->ctx;
     struct gctx *gctx = ctx->gctx;
     ngli_assert(hwconv->src_params.layout == image->params.layout);
 
+    /*
+     * The conversions of a frame are batched: the viewport is saved by the
+     * first one and only restored by ngli_hwconv_end_batch()
+     */
+    if (!ctx->hwconv_batch) {
+        ngli_gctx_get_viewport(gctx, ctx->hwconv_prev_viewport);
+        ctx->hwconv_batch = 1;
+    }
+
     struct rendertarget *rt = hwconv->rt;
     ngli_gctx_begin_render_pass(gctx, rt);
 
-    int prev_vp[4] = {0};
-    ngli_gctx_get_viewport(gctx, prev_vp);
-
     const int vp[4] = {0, 0, rt->width, rt->height};
     ngli_gctx_set_viewport(gctx, vp);
 
-    struct pipeline *pipeline = hwconv->pipeline;
+    struct pipeline *pipeline = hwconv->pipeline->pipeline;
 
-    struct darray *texture_infos_array = &hwconv->crafter->texture_infos;
+    struct darray *texture_infos_array = &hwconv->pipeline->crafter->texture_infos;
     struct pgcraft_texture_info *info = ngli_darray_data(texture_infos_array);
     ngli_assert(ngli_darray_count(texture_infos_array) == 1);
 
@@ -220,23 +323,29 @@ int ngli_hwconv_convert_image(struct hwconv *hwconv, const struct image *image)
     ngli_pipeline_update_uniform(pipeline, fields[NGLI_INFO_FIELD_COORDINATE_MATRIX].index, image->coordinates_matrix);
     ngli_pipeline_update_uniform(pipeline, fields[NGLI_INFO_FIELD_COLOR_MATRIX].index, image->color_matrix);
 
-    ngli_pipeline_draw(hwconv->pipeline, 4, 1);
+    ngli_pipeline_draw(pipeline, 4, 1);
 
     ngli_gctx_end_render_pass(gctx);
-    ngli_gctx_set_viewport(gctx, prev_vp);
 
     return 0;
 }
 
+void ngli_hwconv_end_batch(struct ngl_ctx *ctx)
+{
+    if (!ctx->hwconv_batch)
+        return;
+
+    ngli_gctx_set_viewport(ctx->gctx, ctx->hwconv_prev_viewport);
+    ctx->hwconv_batch = 0;
+}
+
 void ngli_hwconv_reset(struct hwconv *hwconv)
 {
     struct ngl_ctx *ctx = hwconv->ctx;
     if (!ctx)
         return;
 
-    ngli_pipeline_freep(&hwconv->pipeline);
-    ngli_pgcraft_freep(&hwconv->crafter);
-    ngli_buffer_freep(&hwconv->vertices);
+    unref_hwconv_pipeline(hwconv);
     ngli_rendertarget_freep(&hwconv->rt);
 
     memset(hwconv, 0, sizeof(*hwconv));
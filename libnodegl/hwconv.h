@@ -30,15 +30,15 @@
 #include "pipeline.h"
 
 struct ngl_ctx;
+struct hwconv_pipeline;
 
 struct hwconv {
     struct ngl_ctx *ctx;
     struct image_params src_params;
 
     struct rendertarget *rt;
-    struct buffer *vertices;
-    struct pgcraft *crafter;
-    struct pipeline *pipeline;
+    char *pipeline_key;
+    struct hwconv_pipeline *pipeline; // shared with the other hwconv of the context
 };
 
 int ngli_hwconv_init(struct hwconv *hwconv, struct ngl_ctx *ctx,
@@ -46,6 +46,7 @@ int ngli_hwconv_init(struct hwconv *hwconv, struct ngl_ctx *ctx,
                      const struct image_params *src_params);
 
 int ngli_hwconv_convert_image(struct hwconv *hwconv, const struct image *image);
+void ngli_hwconv_end_batch(struct ngl_ctx *ctx);
 void ngli_hwconv_reset(struct hwconv *texconv);
 
 #endif
@@ -104,7 +104,9 @@ static int init_hwconv(struct ngl_node *node)
     };
     ngli_image_init(&s->image, &image_params, &s->texture);
 
+    ngli_profile_start(&ctx->profile, node, NGLI_PROFILE_PHASE_HWCONV_INIT);
     ret = ngli_hwconv_init(hwconv, ctx, &s->image, &mapped_image->params);
+    ngli_profile_stop(&ctx->profile);
     if (ret < 0)
         goto end;
 
@@ -129,8 +131,7 @@ static int exec_hwconv(struct ngl_node *node)
     if (ret < 0)
         return ret;
 
-    if (ngli_texture_has_mipmap(texture))
-        ngli_texture_generate_mipmap(texture);
+    ngli_texture_invalidate_mipmap(texture);
 
     return 0;
 }
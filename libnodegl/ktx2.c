@@ -0,0 +1,319 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "format.h"
+#include "ktx2.h"
+#include "log.h"
+#include "memory.h"
+#include "nodegl.h"
+#include "utils.h"
+
+#define HEADER_SIZE      80
+#define LEVEL_INDEX_SIZE 24
+
+static const uint8_t ktx2_identifier[12] = {
+    0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n',
+};
+
+static const struct {
+    uint32_t vk_format;
+    int format;
+} format_map[] = {
+    {9,   NGLI_FORMAT_R8_UNORM},
+    {16,  NGLI_FORMAT_R8G8_UNORM},
+    {37,  NGLI_FORMAT_R8G8B8A8_UNORM},
+    {43,  NGLI_FORMAT_R8G8B8A8_SRGB},
+    {97,  NGLI_FORMAT_R16G16B16A16_SFLOAT},
+    {109, NGLI_FORMAT_R32G32B32A32_SFLOAT},
+    {133, NGLI_FORMAT_BC1_RGBA_UNORM_BLOCK},
+    {134, NGLI_FORMAT_BC1_RGBA_SRGB_BLOCK},
+    {137, NGLI_FORMAT_BC3_UNORM_BLOCK},
+    {138, NGLI_FORMAT_BC3_SRGB_BLOCK},
+    {145, NGLI_FORMAT_BC7_UNORM_BLOCK},
+    {146, NGLI_FORMAT_BC7_SRGB_BLOCK},
+    {147, NGLI_FORMAT_ETC2_R8G8B8_UNORM_BLOCK},
+    {148, NGLI_FORMAT_ETC2_R8G8B8_SRGB_BLOCK},
+    {151, NGLI_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK},
+    {152, NGLI_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK},
+    {157, NGLI_FORMAT_ASTC_4x4_UNORM_BLOCK},
+    {158, NGLI_FORMAT_ASTC_4x4_SRGB_BLOCK},
+};
+
+static uint32_t read_u32(const uint8_t *p)
+{
+    return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static uint64_t read_u64(const uint8_t *p)
+{
+    return read_u32(p) | (uint64_t)read_u32(p + 4) << 32;
+}
+
+static int get_format(uint32_t vk_format)
+{
+    for (int i = 0; i < NGLI_ARRAY_NB(format_map); i++)
+        if (format_map[i].vk_format == vk_format)
+            return format_map[i].format;
+    return NGLI_FORMAT_UNDEFINED;
+}
+
+int ngli_ktx2_parse(struct ktx2 *s, const uint8_t *data, size_t size)
+{
+    if (size < HEADER_SIZE || memcmp(data, ktx2_identifier, sizeof(ktx2_identifier))) {
+        LOG(ERROR, "invalid KTX2 identifier");
+        return NGL_ERROR_INVALID_DATA;
+    }
+
+    const uint32_t vk_format        = read_u32(data + 12);
+    const uint32_t width            = read_u32(data + 20);
+    const uint32_t height           = read_u32(data + 24);
+    const uint32_t depth            = read_u32(data + 28);
+    const uint32_t nb_layers        = read_u32(data + 32);
+    const uint32_t nb_faces         = read_u32(data + 36);
+    const uint32_t nb_levels        = read_u32(data + 40);
+    const uint32_t supercompression = read_u32(data + 44);
+
+    s->format = get_format(vk_format);
+    if (s->format == NGLI_FORMAT_UNDEFINED) {
+        LOG(ERROR, "unsupported KTX2 format %u", vk_format);
+        return NGL_ERROR_UNSUPPORTED;
+    }
+
+    if (!width || !height || width > 1 << 16 || height > 1 << 16) {
+        LOG(ERROR, "invalid KTX2 dimensions %ux%u", width, height);
+        return NGL_ERROR_INVALID_DATA;
+    }
+
+    if (depth > 1 || nb_layers > 1 || nb_faces != 1) {
+        LOG(ERROR, "only single 2D images are supported in KTX2 files "
+            "(depth=%u layers=%u faces=%u)", depth, nb_layers, nb_faces);
+        return NGL_ERROR_UNSUPPORTED;
+    }
+
+    if (supercompression) {
+        LOG(ERROR, "KTX2 supercompression scheme %u is not supported", supercompression);
+        return NGL_ERROR_UNSUPPORTED;
+    }
+
+    /* A level count of 0 requests the mipmaps to be generated at load time */
+    const uint32_t nb_stored_levels = NGLI_MAX(nb_levels, 1);
+    if (nb_stored_levels > NGLI_KTX2_MAX_LEVELS ||
+        (width | height) >> (nb_stored_levels - 1) == 0) {
+        LOG(ERROR, "invalid KTX2 level count %u for %ux%u", nb_levels, width, height);
+        return NGL_ERROR_INVALID_DATA;
+    }
+
+    if (size < HEADER_SIZE + nb_stored_levels * LEVEL_INDEX_SIZE) {
+        LOG(ERROR, "truncated KTX2 level index");
+        return NGL_ERROR_INVALID_DATA;
+    }
+
+    s->width = width;
+    s->height = height;
+    s->nb_levels = nb_stored_levels;
+
+    const uint8_t *level_index = data + HEADER_SIZE;
+    for (int i = 0; i < s->nb_levels; i++) {
+        const uint64_t offset = read_u64(level_index + i * LEVEL_INDEX_SIZE);
+        const uint64_t length = read_u64(level_index + i * LEVEL_INDEX_SIZE + 8);
+        const int level_width  = NGLI_MAX(s->width  >> i, 1);
+        const int level_height = NGLI_MAX(s->height >> i, 1);
+        const int64_t level_size = ngli_format_get_image_size(s->format, level_width, level_height);
+
+        if (level_size > INT_MAX) {
+            LOG(ERROR, "KTX2 level %d is too large (%dx%d)", i, level_width, level_height);
+            return NGL_ERROR_LIMIT_EXCEEDED;
+        }
+
+        if (offset > size || length > size - offset || length != (uint64_t)level_size) {
+            LOG(ERROR, "invalid KTX2 level %d (offset=%" PRIu64 " length=%" PRIu64 ")",
+                i, offset, length);
+            return NGL_ERROR_INVALID_DATA;
+        }
+
+        struct ktx2_level *level = &s->levels[i];
+        level->data   = data + offset;
+        level->size   = level_size;
+        level->width  = level_width;
+        level->height = level_height;
+    }
+
+    return 0;
+}
+
+int ngli_ktx2_load(struct ktx2 *s, const char *filename)
+{
+    int ret = 0;
+    FILE *fp = fopen(filename, "rb");
+    if (!fp) {
+        LOG(ERROR, "could not open '%s'", filename);
+        return NGL_ERROR_IO;
+    }
+
+    if (fseek(fp, 0, SEEK_END) < 0) {
+        ret = NGL_ERROR_IO;
+        goto end;
+    }
+
+    const long size = ftell(fp);
+    if (size < 0 || fseek(fp, 0, SEEK_SET) < 0) {
+        ret = NGL_ERROR_IO;
+        goto end;
+    }
+
+    s->file_data = ngli_malloc(NGLI_MAX(size, 1));
+    if (!s->file_data) {
+        ret = NGL_ERROR_MEMORY;
+        goto end;
+    }
+
+    if (fread(s->file_data, 1, size, fp) != (size_t)size) {
+        LOG(ERROR, "could not read '%s'", filename);
+        ret = NGL_ERROR_IO;
+        goto end;
+    }
+
+    ret = ngli_ktx2_parse(s, s->file_data, size);
+
+end:
+    fclose(fp);
+    return ret;
+}
+
+int ngli_ktx2_get_transcode_format(int format)
+{
+    switch (format) {
+    case NGLI_FORMAT_BC1_RGBA_UNORM_BLOCK:
+    case NGLI_FORMAT_BC3_UNORM_BLOCK:
+        return NGLI_FORMAT_R8G8B8A8_UNORM;
+    case NGLI_FORMAT_BC1_RGBA_SRGB_BLOCK:
+    case NGLI_FORMAT_BC3_SRGB_BLOCK:
+        return NGLI_FORMAT_R8G8B8A8_SRGB;
+    default:
+        return NGLI_FORMAT_UNDEFINED;
+    }
+}
+
+static void rgb565_to_rgba8(uint8_t *dst, uint16_t c)
+{
+    const int r = c >> 11 & 0x1f;
+    const int g = c >>  5 & 0x3f;
+    const int b = c       & 0x1f;
+    dst[0] = r << 3 | r >> 2;
+    dst[1] = g << 2 | g >> 4;
+    dst[2] = b << 3 | b >> 2;
+    dst[3] = 0xff;
+}
+
+static void decode_bc1_colors(const uint8_t *block, uint8_t colors[4][4], int allow_transparency)
+{
+    const uint16_t c0 = block[0] | block[1] << 8;
+    const uint16_t c1 = block[2] | block[3] << 8;
+
+    rgb565_to_rgba8(colors[0], c0);
+    rgb565_to_rgba8(colors[1], c1);
+    if (c0 > c1 || !allow_transparency) {
+        for (int i = 0; i < 3; i++) {
+            colors[2][i] = (2 * colors[0][i] + colors[1][i] + 1) / 3;
+            colors[3][i] = (colors[0][i] + 2 * colors[1][i] + 1) / 3;
+        }
+        colors[2][3] = colors[3][3] = 0xff;
+    } else {
+        for (int i = 0; i < 3; i++)
+            colors[2][i] = (colors[0][i] + colors[1][i]) / 2;
+        colors[2][3] = 0xff;
+        memset(colors[3], 0, sizeof(colors[3]));
+    }
+}
+
+static void decode_bc3_alphas(const uint8_t *block, uint8_t alphas[8])
+{
+    alphas[0] = block[0];
+    alphas[1] = block[1];
+    if (alphas[0] > alphas[1]) {
+        for (int i = 1; i < 7; i++)
+            alphas[i + 1] = ((7 - i) * alphas[0] + i * alphas[1] + 3) / 7;
+    } else {
+        for (int i = 1; i < 5; i++)
+            alphas[i + 1] = ((5 - i) * alphas[0] + i * alphas[1] + 2) / 5;
+        alphas[6] = 0x00;
+        alphas[7] = 0xff;
+    }
+}
+
+static void decode_block(int format, const uint8_t *block, uint8_t texels[16][4])
+{
+    uint8_t colors[4][4];
+
+    if (format == NGLI_FORMAT_BC1_RGBA_UNORM_BLOCK || format == NGLI_FORMAT_BC1_RGBA_SRGB_BLOCK) {
+        decode_bc1_colors(block, colors, 1);
+        const uint32_t indices = read_u32(block + 4);
+        for (int i = 0; i < 16; i++)
+            memcpy(texels[i], colors[indices >> (2 * i) & 3], 4);
+        return;
+    }
+
+    uint8_t alphas[8];
+    decode_bc3_alphas(block, alphas);
+    decode_bc1_colors(block + 8, colors, 0);
+    const uint64_t alpha_indices = read_u64(block) >> 16;
+    const uint32_t color_indices = read_u32(block + 12);
+    for (int i = 0; i < 16; i++) {
+        memcpy(texels[i], colors[color_indices >> (2 * i) & 3], 3);
+        texels[i][3] = alphas[alpha_indices >> (3 * i) & 7];
+    }
+}
+
+int ngli_ktx2_transcode_level(const struct ktx2 *s, int level, uint8_t *dst)
+{
+    if (ngli_ktx2_get_transcode_format(s->format) == NGLI_FORMAT_UNDEFINED)
+        return NGL_ERROR_UNSUPPORTED;
+
+    const struct ktx2_level *l = &s->levels[level];
+    const int block_size = ngli_format_get_block_size(s->format);
+    const uint8_t *block = l->data;
+
+    for (int by = 0; by < l->height; by += 4) {
+        for (int bx = 0; bx < l->width; bx += 4) {
+            uint8_t texels[16][4];
+            decode_block(s->format, block, texels);
+            block += block_size;
+
+            const int w = NGLI_MIN(l->width  - bx, 4);
+            const int h = NGLI_MIN(l->height - by, 4);
+            for (int y = 0; y < h; y++)
+                memcpy(dst + ((by + y) * l->width + bx) * 4, texels[y * 4], w * 4);
+        }
+    }
+
+    return 0;
+}
+
+void ngli_ktx2_reset(struct ktx2 *s)
+{
+    ngli_free(s->file_data);
+    memset(s, 0, sizeof(*s));
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef KTX2_H
+#define KTX2_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define NGLI_KTX2_MAX_LEVELS 16
+
+struct ktx2_level {
+    const uint8_t *data;
+    int size;
+    int width;
+    int height;
+};
+
+struct ktx2 {
+    int format;
+    int width;
+    int height;
+    int nb_levels;
+    struct ktx2_level levels[NGLI_KTX2_MAX_LEVELS];
+    uint8_t *file_data;
+};
+
+/*
+ * Parse a KTX2 container held in memory. The levels reference the input data
+ * which must outlive the ktx2 structure.
+ */
+int ngli_ktx2_parse(struct ktx2 *s, const uint8_t *data, size_t size);
+
+/*
+ * Load and parse a KTX2 file; the file content is owned by the structure and
+ * released with ngli_ktx2_reset().
+ */
+int ngli_ktx2_load(struct ktx2 *s, const char *filename);
+
+/*
+ * Return the uncompressed format the given compressed format can be
+ * transcoded to on the CPU, or NGLI_FORMAT_UNDEFINED if there is none.
+ */
+int ngli_ktx2_get_transcode_format(int format);
+
+/*
+ * Transcode a compressed level to its uncompressed format (see
+ * ngli_ktx2_get_transcode_format()); dst must hold width*height RGBA texels.
+ */
+int ngli_ktx2_transcode_level(const struct ktx2 *s, int level, uint8_t *dst);
+
+void ngli_ktx2_reset(struct ktx2 *s);
+
+#endif
@@ -0,0 +1,632 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "memory.h"
+#include "meshopt.h"
+#include "nodegl.h"
+#include "utils.h"
+
+/* Size of the LRU cache modeled by the vertex cache optimizer */
+#define LRU_CACHE_SIZE 32
+
+#define CACHE_DECAY_POWER   1.5f
+#define LAST_TRIANGLE_SCORE 0.75f
+#define VALENCE_BOOST_SCALE 2.0f
+#define VALENCE_BOOST_POWER 0.5f
+
+/* Maximum ACMR increase allowed by the overdraw clusters over the input */
+#define OVERDRAW_ACMR_THRESHOLD 1.05f
+
+static int check_indices(const uint32_t *indices, int nb_indices, int nb_vertices)
+{
+    if (nb_indices % 3)
+        return NGL_ERROR_INVALID_ARG;
+    for (int i = 0; i < nb_indices; i++)
+        if (indices[i] >= (uint32_t)nb_vertices)
+            return NGL_ERROR_INVALID_ARG;
+    return 0;
+}
+
+static float get_vertex_score(int cache_pos, int nb_live_triangles)
+{
+    if (!nb_live_triangles)
+        return -1.f;
+
+    float score = 0.f;
+    if (cache_pos >= 0) {
+        if (cache_pos < 3) {
+            score = LAST_TRIANGLE_SCORE;
+        } else {
+            const float scale = 1.f / (LRU_CACHE_SIZE - 3);
+            score = powf(1.f - (cache_pos - 3) * scale, CACHE_DECAY_POWER);
+        }
+    }
+    return score + VALENCE_BOOST_SCALE * powf((float)nb_live_triangles, -VALENCE_BOOST_POWER);
+}
+
+struct vcache_ctx {
+    int *nb_live;           // number of triangles not emitted yet, per vertex
+    int *offsets;           // offset of the triangles of each vertex in triangles
+    int *triangles;         // triangles of each vertex, the live ones first
+    int *cache_pos;         // position of each vertex in the cache, or -1
+    float *vertex_scores;
+    uint8_t *emitted;
+};
+
+static void vcache_ctx_reset(struct vcache_ctx *s)
+{
+    ngli_freep(&s->nb_live);
+    ngli_freep(&s->offsets);
+    ngli_freep(&s->triangles);
+    ngli_freep(&s->cache_pos);
+    ngli_freep(&s->vertex_scores);
+    ngli_freep(&s->emitted);
+}
+
+static int vcache_ctx_init(struct vcache_ctx *s, const uint32_t *indices, int nb_indices, int nb_vertices)
+{
+    const int nb_triangles = nb_indices / 3;
+
+    s->nb_live         = ngli_calloc(nb_vertices, sizeof(*s->nb_live));
+    s->offsets         = ngli_calloc(nb_vertices + 1, sizeof(*s->offsets));
+    s->triangles       = ngli_calloc(nb_indices ? nb_indices : 1, sizeof(*s->triangles));
+    s->cache_pos       = ngli_calloc(nb_vertices, sizeof(*s->cache_pos));
+    s->vertex_scores   = ngli_calloc(nb_vertices, sizeof(*s->vertex_scores));
+    s->emitted         = ngli_calloc(nb_triangles ? nb_triangles : 1, sizeof(*s->emitted));
+    if (!s->nb_live || !s->offsets || !s->triangles || !s->cache_pos ||
+        !s->vertex_scores || !s->emitted)
+        return NGL_ERROR_MEMORY;
+
+    for (int i = 0; i < nb_indices; i++)
+        s->nb_live[indices[i]]++;
+
+    for (int i = 0; i < nb_vertices; i++)
+        s->offsets[i + 1] = s->offsets[i] + s->nb_live[i];
+
+    int *fill = s->cache_pos; // used as a temporary cursor before the cache setup
+    for (int i = 0; i < nb_vertices; i++)
+        fill[i] = s->offsets[i];
+    for (int i = 0; i < nb_indices; i++)
+        s->triangles[fill[indices[i]]++] = i / 3;
+
+    for (int i = 0; i < nb_vertices; i++) {
+        s->cache_pos[i] = -1;
+        s->vertex_scores[i] = get_vertex_score(-1, s->nb_live[i]);
+    }
+
+    return 0;
+}
+
+static void remove_live_triangle(struct vcache_ctx *s, uint32_t vertex, int triangle)
+{
+    int *triangles = s->triangles + s->offsets[vertex];
+    const int nb_live = s->nb_live[vertex];
+    for (int i = 0; i < nb_live; i++) {
+        if (triangles[i] == triangle) {
+            triangles[i] = triangles[nb_live - 1];
+            triangles[nb_live - 1] = triangle;
+            break;
+        }
+    }
+    s->nb_live[vertex]--;
+}
+
+int ngli_meshopt_optimize_vertex_cache(uint32_t *dst, const uint32_t *indices,
+                                       int nb_indices, int nb_vertices)
+{
+    int ret = check_indices(indices, nb_indices, nb_vertices);
+    if (ret < 0 || !nb_indices)
+        return ret;
+
+    struct vcache_ctx s = {0};
+    ret = vcache_ctx_init(&s, indices, nb_indices, nb_vertices);
+    if (ret < 0)
+        goto end;
+
+    uint32_t cache[LRU_CACHE_SIZE + 3];
+    int cache_count = 0;
+
+    const int nb_triangles = nb_indices / 3;
+    int best_triangle = -1;
+    int cursor = 0;
+    for (int n = 0; n < nb_triangles; n++) {
+        if (best_triangle < 0) {
+            /* dead end: restart from the next triangle not emitted yet */
+            while (s.emitted[cursor])
+                cursor++;
+            best_triangle = cursor;
+        }
+
+        const uint32_t *tri = indices + best_triangle * 3;
+        memcpy(dst + n * 3, tri, 3 * sizeof(*tri));
+        s.emitted[best_triangle] = 1;
+
+        for (int i = 0; i < 3; i++)
+            remove_live_triangle(&s, tri[i], best_triangle);
+
+        /* the vertices of the emitted triangle move to the front of the cache */
+        uint32_t new_cache[LRU_CACHE_SIZE + 3];
+        int new_cache_count = 0;
+        for (int i = 0; i < 3; i++) {
+            int found = 0;
+            for (int j = 0; j < new_cache_count && !found; j++)
+                found = new_cache[j] == tri[i];
+            if (!found)
+                new_cache[new_cache_count++] = tri[i];
+        }
+        for (int i = 0; i < cache_count; i++) {
+            const uint32_t vertex = cache[i];
+            if (vertex != tri[0] && vertex != tri[1] && vertex != tri[2])
+                new_cache[new_cache_count++] = vertex;
+        }
+
+        for (int i = 0; i < new_cache_count; i++) {
+            const uint32_t vertex = new_cache[i];
+            s.cache_pos[vertex] = i < LRU_CACHE_SIZE ? i : -1;
+            s.vertex_scores[vertex] = get_vertex_score(s.cache_pos[vertex], s.nb_live[vertex]);
+        }
+        cache_count = NGLI_MIN(new_cache_count, LRU_CACHE_SIZE);
+        memcpy(cache, new_cache, cache_count * sizeof(*cache));
+
+        /* only the triangles referencing cached vertices are candidates */
+        best_triangle = -1;
+        float best_score = 0.f;
+        for (int i = 0; i < cache_count; i++) {
+            const uint32_t vertex = cache[i];
+            const int *triangles = s.triangles + s.offsets[vertex];
+            for (int j = 0; j < s.nb_live[vertex]; j++) {
+                const int triangle = triangles[j];
+                const uint32_t *t = indices + triangle * 3;
+                const float score = s.vertex_scores[t[0]] +
+                                    s.vertex_scores[t[1]] +
+                                    s.vertex_scores[t[2]];
+                if (score > best_score) {
+                    best_score = score;
+                    best_triangle = triangle;
+                }
+            }
+        }
+    }
+
+end:
+    vcache_ctx_reset(&s);
+    return ret;
+}
+
+static int get_triangle_misses(int *timestamps, int *time, const uint32_t *triangle)
+{
+    int nb_misses = 0;
+    for (int j = 0; j < 3; j++) {
+        const uint32_t vertex = triangle[j];
+        if (*time - timestamps[vertex] > NGLI_MESHOPT_CACHE_SIZE) {
+            timestamps[vertex] = (*time)++;
+            nb_misses++;
+        }
+    }
+    return nb_misses;
+}
+
+#define FLUSH_CACHE(time) ((time) += NGLI_MESHOPT_CACHE_SIZE + 1)
+
+int ngli_meshopt_get_overdraw_clusters(int *starts, const uint32_t *indices, int nb_indices, int nb_vertices)
+{
+    int ret = check_indices(indices, nb_indices, nb_vertices);
+    if (ret < 0)
+        return ret;
+
+    const int nb_triangles = nb_indices / 3;
+    if (!nb_triangles)
+        return 0;
+
+    int *hard_starts = ngli_calloc(nb_triangles, sizeof(*hard_starts));
+    int *timestamps = ngli_calloc(nb_vertices, sizeof(*timestamps));
+    if (!hard_starts || !timestamps) {
+        ret = NGL_ERROR_MEMORY;
+        goto end;
+    }
+
+    /* hard boundaries: the triangles missing all their vertices flush the cache */
+    int nb_hard_clusters = 0;
+    int time = NGLI_MESHOPT_CACHE_SIZE + 1;
+    for (int i = 0; i < nb_triangles; i++) {
+        const int nb_misses = get_triangle_misses(timestamps, &time, indices + i * 3);
+        if (!nb_hard_clusters || nb_misses == 3)
+            hard_starts[nb_hard_clusters++] = i;
+    }
+
+    /*
+     * Soft boundaries: a cluster, simulated from an empty cache, ends as soon
+     * as its ACMR gets below the threshold relative to the ACMR of its hard
+     * cluster, which bounds the vertex cache efficiency lost by the reordering
+     */
+    int nb_clusters = 0;
+    for (int c = 0; c < nb_hard_clusters; c++) {
+        const int start = hard_starts[c];
+        const int end = c + 1 < nb_hard_clusters ? hard_starts[c + 1] : nb_triangles;
+
+        int hard_misses = 0;
+        FLUSH_CACHE(time);
+        for (int i = start; i < end; i++)
+            hard_misses += get_triangle_misses(timestamps, &time, indices + i * 3);
+        const float threshold = OVERDRAW_ACMR_THRESHOLD * hard_misses / (float)(end - start);
+
+        starts[nb_clusters++] = start;
+        int nb_misses = 0;
+        int nb_cluster_triangles = 0;
+        FLUSH_CACHE(time);
+        for (int i = start; i < end - 1; i++) {
+            nb_misses += get_triangle_misses(timestamps, &time, indices + i * 3);
+            nb_cluster_triangles++;
+            if (nb_misses <= threshold * nb_cluster_triangles) {
+                starts[nb_clusters++] = i + 1;
+                nb_misses = 0;
+                nb_cluster_triangles = 0;
+                FLUSH_CACHE(time);
+            }
+        }
+    }
+    ret = nb_clusters;
+
+end:
+    ngli_freep(&hard_starts);
+    ngli_freep(&timestamps);
+    return ret;
+}
+
+struct cluster {
+    float sort_key;
+    int id;
+    int start;
+    int nb_triangles;
+};
+
+static int cmp_cluster(const void *a, const void *b)
+{
+    const struct cluster *c0 = a;
+    const struct cluster *c1 = b;
+    if (c0->sort_key != c1->sort_key)
+        return c0->sort_key < c1->sort_key ? 1 : -1;
+    return c0->id - c1->id;
+}
+
+static void get_triangle_normal(float *dst, const float *p0, const float *p1, const float *p2)
+{
+    const float u[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+    const float v[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+    dst[0] = u[1] * v[2] - u[2] * v[1];
+    dst[1] = u[2] * v[0] - u[0] * v[2];
+    dst[2] = u[0] * v[1] - u[1] * v[0];
+}
+
+int ngli_meshopt_optimize_overdraw(uint32_t *dst, const uint32_t *indices, int nb_indices,
+                                   const float *positions, int nb_vertices)
+{
+    int ret = check_indices(indices, nb_indices, nb_vertices);
+    if (ret < 0)
+        return ret;
+
+    const int nb_triangles = nb_indices / 3;
+    if (!nb_triangles)
+        return 0;
+
+    struct cluster *clusters = ngli_calloc(nb_triangles, sizeof(*clusters));
+    int *starts = ngli_calloc(nb_triangles, sizeof(*starts));
+    if (!clusters || !starts) {
+        ret = NGL_ERROR_MEMORY;
+        goto end;
+    }
+
+    const int nb_clusters = ngli_meshopt_get_overdraw_clusters(starts, indices, nb_indices, nb_vertices);
+    if (nb_clusters < 0) {
+        ret = nb_clusters;
+        goto end;
+    }
+    for (int c = 0; c < nb_clusters; c++) {
+        const int end = c + 1 < nb_clusters ? starts[c + 1] : nb_triangles;
+        clusters[c].id = c;
+        clusters[c].start = starts[c];
+        clusters[c].nb_triangles = end - starts[c];
+    }
+
+    /* area weighted centroid of the mesh */
+    float mesh_centroid[3] = {0};
+    float mesh_area = 0.f;
+    for (int i = 0; i < nb_triangles; i++) {
+        const float *p0 = positions + indices[i * 3 + 0] * 3;
+        const float *p1 = positions + indices[i * 3 + 1] * 3;
+        const float *p2 = positions + indices[i * 3 + 2] * 3;
+        float normal[3];
+        get_triangle_normal(normal, p0, p1, p2);
+        const float area = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        for (int k = 0; k < 3; k++)
+            mesh_centroid[k] += area * (p0[k] + p1[k] + p2[k]) / 3.f;
+        mesh_area += area;
+    }
+    if (mesh_area > 0.f)
+        for (int k = 0; k < 3; k++)
+            mesh_centroid[k] /= mesh_area;
+
+    /*
+     * Clusters facing away from the mesh center are more likely to occlude
+     * the others and are drawn first.
+     */
+    for (int c = 0; c < nb_clusters; c++) {
+        struct cluster *cluster = &clusters[c];
+        float centroid[3] = {0};
+        float normal_sum[3] = {0};
+        float area_sum = 0.f;
+        for (int i = cluster->start; i < cluster->start + cluster->nb_triangles; i++) {
+            const float *p0 = positions + indices[i * 3 + 0] * 3;
+            const float *p1 = positions + indices[i * 3 + 1] * 3;
+            const float *p2 = positions + indices[i * 3 + 2] * 3;
+            float normal[3];
+            get_triangle_normal(normal, p0, p1, p2);
+            const float area = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            for (int k = 0; k < 3; k++) {
+                centroid[k] += area * (p0[k] + p1[k] + p2[k]) / 3.f;
+                normal_sum[k] += normal[k];
+            }
+            area_sum += area;
+        }
+
+        const float normal_len = sqrtf(normal_sum[0] * normal_sum[0] +
+                                       normal_sum[1] * normal_sum[1] +
+                                       normal_sum[2] * normal_sum[2]);
+        if (area_sum <= 0.f || normal_len <= 0.f)
+            continue;
+
+        float sort_key = 0.f;
+        for (int k = 0; k < 3; k++)
+            sort_key += (centroid[k] / area_sum - mesh_centroid[k]) * normal_sum[k] / normal_len;
+        cluster->sort_key = sort_key;
+    }
+
+    qsort(clusters, nb_clusters, sizeof(*clusters), cmp_cluster);
+
+    uint32_t *p = dst;
+    for (int c = 0; c < nb_clusters; c++) {
+        const struct cluster *cluster = &clusters[c];
+        const int count = cluster->nb_triangles * 3;
+        memcpy(p, indices + cluster->start * 3, count * sizeof(*indices));
+        p += count;
+    }
+
+end:
+    ngli_freep(&clusters);
+    ngli_freep(&starts);
+    return ret;
+}
+
+int ngli_meshopt_optimize_vertex_fetch(uint32_t *remap, uint32_t *indices,
+                                       int nb_indices, int nb_vertices)
+{
+    int ret = check_indices(indices, nb_indices, nb_vertices);
+    if (ret < 0)
+        return ret;
+
+    memset(remap, 0xff, nb_vertices * sizeof(*remap));
+
+    uint32_t next = 0;
+    for (int i = 0; i < nb_indices; i++) {
+        const uint32_t vertex = indices[i];
+        if (remap[vertex] == UINT32_MAX)
+            remap[vertex] = next++;
+        indices[i] = remap[vertex];
+    }
+
+    for (int i = 0; i < nb_vertices; i++)
+        if (remap[i] == UINT32_MAX)
+            remap[i] = next++;
+
+    return 0;
+}
+
+int ngli_meshopt_remap_vertices(void *data, int count, int stride, const uint32_t *remap)
+{
+    const size_t size = (size_t)count * stride;
+    uint8_t *src = ngli_malloc(size ? size : 1);
+    if (!src)
+        return NGL_ERROR_MEMORY;
+    memcpy(src, data, size);
+
+    uint8_t *dst = data;
+    for (int i = 0; i < count; i++)
+        memcpy(dst + remap[i] * stride, src + i * stride, stride);
+
+    ngli_free(src);
+    return 0;
+}
+
+/*
+ * Check if the triangle t can be appended to a strip ending with the vertices
+ * p and q: the strip triangles alternate their winding, so an odd triangle
+ * must be (q, p, r) instead of (p, q, r).
+ */
+static int continue_strip(const uint32_t *t, uint32_t p, uint32_t q, int odd, uint32_t *rp)
+{
+    for (int i = 0; i < 3; i++) {
+        const uint32_t a = t[i];
+        const uint32_t b = t[(i + 1) % 3];
+        if ((!odd && a == p && b == q) || (odd && a == q && b == p)) {
+            *rp = t[(i + 2) % 3];
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int ngli_meshopt_convert_to_strip(uint32_t *dst, const uint32_t *indices, int nb_indices,
+                                  uint32_t restart_index)
+{
+    int n = 0;
+    int strip_len = 0;
+    for (int i = 0; i + 2 < nb_indices; i += 3) {
+        const uint32_t *t = indices + i;
+
+        uint32_t r;
+        if (strip_len && continue_strip(t, dst[n - 2], dst[n - 1], strip_len & 1, &r)) {
+            dst[n++] = r;
+            strip_len++;
+            continue;
+        }
+
+        if (strip_len)
+            dst[n++] = restart_index;
+
+        /* start the strip with the rotation allowing the next triangle to continue it */
+        int rot = 0;
+        for (int k = 0; i + 5 < nb_indices && k < 3; k++) {
+            if (continue_strip(t + 3, t[(k + 1) % 3], t[(k + 2) % 3], 1, &r)) {
+                rot = k;
+                break;
+            }
+        }
+        for (int k = 0; k < 3; k++)
+            dst[n++] = t[(rot + k) % 3];
+        strip_len = 1;
+    }
+    return n;
+}
+
+uint16_t ngli_meshopt_float_to_half(float f)
+{
+    union { float f; uint32_t u; } v = {.f = f};
+    const uint16_t sign = (v.u >> 16) & 0x8000;
+    const uint32_t u = v.u & 0x7fffffff;
+
+    if (u >= 0x7f800000) // infinity or NaN
+        return sign | 0x7c00 | (u > 0x7f800000 ? 0x200 : 0);
+    if (u >= 0x477ff000) // rounds to infinity (>= 65520)
+        return sign | 0x7c00;
+
+    if (u < 0x38800000) { // subnormal half (< 2^-14)
+        if (u < 0x33000000) // rounds to zero (<= 2^-25)
+            return sign;
+        const uint32_t mant = (u & 0x7fffff) | 0x800000;
+        const int shift = 126 - (u >> 23);
+        uint32_t h = mant >> shift;
+        const uint32_t rem = mant & ((1U << shift) - 1);
+        const uint32_t halfway = 1U << (shift - 1);
+        if (rem > halfway || (rem == halfway && (h & 1)))
+            h++;
+        return sign | h;
+    }
+
+    /* rebias the exponent and round the mantissa to nearest even */
+    uint32_t h = (u - 0x38000000) >> 13;
+    const uint32_t rem = u & 0x1fff;
+    if (rem > 0x1000 || (rem == 0x1000 && (h & 1)))
+        h++;
+    return sign | h;
+}
+
+float ngli_meshopt_half_to_float(uint16_t h)
+{
+    const float sign = h & 0x8000 ? -1.f : 1.f;
+    const int exp = (h >> 10) & 0x1f;
+    const int mant = h & 0x3ff;
+    if (exp == 0x1f)
+        return mant ? NAN : sign * INFINITY;
+    if (exp == 0)
+        return sign * ldexpf((float)mant, -24);
+    return sign * ldexpf((float)(mant | 0x400), exp - 25);
+}
+
+float ngli_meshopt_quantize_half(uint8_t *dst, int dst_stride, const float *src, int nb_comp, int count)
+{
+    static const float padding[4] = {0.f, 0.f, 0.f, 1.f};
+    float max_error = 0.f;
+    for (int i = 0; i < count; i++) {
+        uint16_t q[4];
+        for (int c = 0; c < 4; c++) {
+            const float v = c < nb_comp ? src[i * nb_comp + c] : padding[c];
+            q[c] = ngli_meshopt_float_to_half(v);
+            const float error = fabsf(ngli_meshopt_half_to_float(q[c]) - v);
+            max_error = error > max_error || error != error ? error : max_error;
+        }
+        if (dst)
+            memcpy(dst + i * dst_stride, q, sizeof(q));
+    }
+    return max_error;
+}
+
+float ngli_meshopt_quantize_snorm8(uint8_t *dst, int dst_stride, const float *src, int nb_comp, int count)
+{
+    float max_error = 0.f;
+    for (int i = 0; i < count; i++) {
+        int8_t q[4] = {0};
+        for (int c = 0; c < NGLI_MIN(nb_comp, 4); c++) {
+            const float v = src[i * nb_comp + c];
+            q[c] = (int8_t)lrintf(NGLI_MIN(NGLI_MAX(v, -1.f), 1.f) * 127.f);
+            const float error = fabsf(NGLI_MAX(q[c] / 127.f, -1.f) - v);
+            max_error = NGLI_MAX(max_error, error);
+        }
+        if (dst)
+            memcpy(dst + i * dst_stride, q, sizeof(q));
+    }
+    return max_error;
+}
+
+float ngli_meshopt_quantize_unorm16(uint8_t *dst, int dst_stride, const float *src, int nb_comp, int count)
+{
+    float max_error = 0.f;
+    for (int i = 0; i < count; i++) {
+        uint16_t q[4] = {0};
+        for (int c = 0; c < NGLI_MIN(nb_comp, 4); c++) {
+            const float v = src[i * nb_comp + c];
+            q[c] = (uint16_t)lrintf(NGLI_MIN(NGLI_MAX(v, 0.f), 1.f) * 65535.f);
+            const float error = fabsf(q[c] / 65535.f - v);
+            max_error = NGLI_MAX(max_error, error);
+        }
+        if (dst)
+            memcpy(dst + i * dst_stride, q, nb_comp * sizeof(*q));
+    }
+    return max_error;
+}
+
+int ngli_meshopt_get_cache_misses(const uint32_t *indices, int nb_indices,
+                                  int nb_vertices, int cache_size)
+{
+    int ret = check_indices(indices, nb_indices, nb_vertices);
+    if (ret < 0)
+        return ret;
+
+    int *timestamps = ngli_calloc(nb_vertices ? nb_vertices : 1, sizeof(*timestamps));
+    if (!timestamps)
+        return NGL_ERROR_MEMORY;
+
+    int nb_misses = 0;
+    int time = cache_size + 1;
+    for (int i = 0; i < nb_indices; i++) {
+        const uint32_t vertex = indices[i];
+        if (time - timestamps[vertex] > cache_size) {
+            timestamps[vertex] = time++;
+            nb_misses++;
+        }
+    }
+
+    ngli_free(timestamps);
+    return nb_misses;
+}
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef MESHOPT_H
+#define MESHOPT_H
+
+#include <stdint.h>
+
+/*
+ * Size of the FIFO post-transform vertex cache used to measure the
+ * optimizations, close to what most hardware implement.
+ */
+#define NGLI_MESHOPT_CACHE_SIZE 16
+
+/*
+ * Reorder the triangles of an indexed triangle list for post-transform vertex
+ * cache locality (Forsyth, "Linear-Speed Vertex Cache Optimisation"). The
+ * vertex indices of each triangle are preserved. dst and indices must not
+ * overlap.
+ */
+int ngli_meshopt_optimize_vertex_cache(uint32_t *dst, const uint32_t *indices,
+                                       int nb_indices, int nb_vertices);
+
+/*
+ * Split a cache optimized triangle list into the clusters reordered by
+ * ngli_meshopt_optimize_overdraw(): a cluster starts at each triangle sharing
+ * no vertex with the simulated cache, and these are further split where the
+ * ACMR of the current cluster falls within 5% of the ACMR of the enclosing
+ * one (Sander et al.). starts receives the first triangle of each cluster
+ * and must hold nb_indices / 3 entries; the number of clusters is returned.
+ */
+int ngli_meshopt_get_overdraw_clusters(int *starts, const uint32_t *indices, int nb_indices, int nb_vertices);
+
+/*
+ * Reorder the clusters of a cache optimized triangle list so the triangles
+ * facing outward are drawn first, reducing overdraw (Sander et al., "Fast
+ * Triangle Reordering for Vertex Locality and Reduced Overdraw"). The
+ * clusters are sorted by decreasing dot product between their average
+ * normal and the offset of their centroid from the mesh centroid.
+ * positions holds 3 floats per vertex. dst and indices must not overlap.
+ */
+int ngli_meshopt_optimize_overdraw(uint32_t *dst, const uint32_t *indices, int nb_indices,
+                                   const float *positions, int nb_vertices);
+
+/*
+ * Renumber the vertices in the order of their first use by the indices, which
+ * are rewritten in place, for vertex fetch locality. remap receives the new
+ * index of each of the nb_vertices vertices; the unreferenced vertices are
+ * moved at the end.
+ */
+int ngli_meshopt_optimize_vertex_fetch(uint32_t *remap, uint32_t *indices,
+                                       int nb_indices, int nb_vertices);
+
+/*
+ * Reorder in place count vertex attributes of stride bytes according to the
+ * remap table returned by ngli_meshopt_optimize_vertex_fetch().
+ */
+int ngli_meshopt_remap_vertices(void *data, int count, int stride, const uint32_t *remap);
+
+/*
+ * Convert an indexed triangle list into triangle strips separated by
+ * restart_index, preserving the order and winding of the triangles. A new
+ * strip starts each time a triangle does not continue the current one. dst
+ * must hold at least nb_indices / 3 * 4 indices; the number of indices
+ * written is returned.
+ */
+int ngli_meshopt_convert_to_strip(uint32_t *dst, const uint32_t *indices, int nb_indices,
+                                  uint32_t restart_index);
+
+/*
+ * Vertex attribute quantization: count elements of nb_comp floats are
+ * converted to the specified storage and written to dst (if not NULL) every
+ * dst_stride bytes. The maximum absolute error over all the components is
+ * returned (infinite if a value can not be represented).
+ *
+ * - half: 4 half floats, the missing components are filled with (0, 0, 1)
+ *   suitable for positions
+ * - snorm8: 4 signed normalized bytes, the missing components are zeroed
+ * - unorm16: nb_comp unsigned normalized shorts
+ */
+float ngli_meshopt_quantize_half(uint8_t *dst, int dst_stride, const float *src, int nb_comp, int count);
+float ngli_meshopt_quantize_snorm8(uint8_t *dst, int dst_stride, const float *src, int nb_comp, int count);
+float ngli_meshopt_quantize_unorm16(uint8_t *dst, int dst_stride, const float *src, int nb_comp, int count);
+
+uint16_t ngli_meshopt_float_to_half(float f);
+float ngli_meshopt_half_to_float(uint16_t h);
+
+/*
+ * Simulate a FIFO vertex cache of cache_size entries over an indexed triangle
+ * list and return the number of cache misses, or a negative error code. The
+ * average cache miss ratio (ACMR) is this number divided by the triangle
+ * count.
+ */
+int ngli_meshopt_get_cache_misses(const uint32_t *indices, int nb_indices,
+                                  int nb_vertices, int cache_size);
+
+#endif
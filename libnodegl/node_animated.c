@@ -28,6 +28,7 @@
 #include "nodegl.h"
 #include "nodes.h"
 #include "type.h"
+#include "utils.h"
 
 #define OFFSET(x) offsetof(struct variable_priv, x)
 static const struct node_param animatedtime_params[] = {
@@ -274,7 +275,17 @@ static int animatedquat_init(struct ngl_node *node)
 static int animation_update(struct ngl_node *node, double t)
 {
     struct variable_priv *s = node->priv_data;
-    return ngli_animation_evaluate(&s->anim, s->data, t);
+    uint8_t prev_data[sizeof(s->matrix)];
+    ngli_assert(s->data_size <= sizeof(prev_data));
+    memcpy(prev_data, s->data, s->data_size);
+
+    int ret = ngli_animation_evaluate(&s->anim, s->data, t);
+    if (ret < 0)
+        return ret;
+
+    if (memcmp(prev_data, s->data, s->data_size))
+        node->ctx->frame_changed = 1;
+    return 0;
 }
 
 #define animatedtime_update  animation_update
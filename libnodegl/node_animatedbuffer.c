@@ -63,6 +63,7 @@ static void cpy_buffer(void *user_arg, void *dst,
 static int animatedbuffer_update(struct ngl_node *node, double t)
 {
     struct buffer_priv *s = node->priv_data;
+    node->ctx->frame_changed = 1;
     return ngli_animation_evaluate(&s->anim, s->data, t);
 }
 
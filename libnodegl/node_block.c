@@ -144,10 +144,12 @@ int ngli_node_block_init(struct ngl_node *node)
     if (ret < 0)
         return ret;
 
-    ret = ngli_buffer_upload(s->buffer, s->data, s->data_size);
+    ret = ngli_buffer_upload(s->buffer, s->data, s->data_size, 0);
     if (ret < 0)
         return ret;
 
+    memset(s->dirty_fields, 0, s->nb_fields);
+
     return 0;
 }
 
@@ -160,12 +162,51 @@ void ngli_node_block_unref(struct ngl_node *node)
         ngli_buffer_freep(&s->buffer);
 }
 
+/*
+ * Fields separated by less than this amount of bytes (typically alignment
+ * padding) are uploaded within the same range
+ */
+#define RANGE_MERGE_GAP 16
+
+static int upload_dirty_ranges(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct block_priv *s = node->priv_data;
+    const struct block_field *field_info = ngli_darray_data(&s->block.fields);
+
+    int start = -1, end = -1;
+    for (int i = 0; i <= s->nb_fields; i++) {
+        if (i < s->nb_fields && !s->dirty_fields[i])
+            continue;
+
+        /* Flush the pending range if the next dirty field is not adjacent */
+        if (start >= 0 && (i == s->nb_fields || field_info[i].offset - end > RANGE_MERGE_GAP)) {
+            int ret = ngli_buffer_upload(s->buffer, s->data + start, end - start, start);
+            if (ret < 0)
+                return ret;
+            ctx->block_upload_size += end - start;
+            start = -1;
+        }
+
+        if (i == s->nb_fields)
+            break;
+
+        const struct block_field *fi = &field_info[i];
+        if (start < 0)
+            start = fi->offset;
+        end = fi->offset + fi->size;
+        s->dirty_fields[i] = 0;
+    }
+
+    return 0;
+}
+
 int ngli_node_block_upload(struct ngl_node *node)
 {
     struct block_priv *s = node->priv_data;
 
     if (s->has_changed && s->buffer_last_upload_time != node->last_update_time) {
-        int ret = ngli_buffer_upload(s->buffer, s->data, s->data_size);
+        int ret = upload_dirty_ranges(node);
         if (ret < 0)
             return ret;
         s->buffer_last_upload_time = node->last_update_time;
@@ -247,7 +288,8 @@ static void update_block_data(struct block_priv *s, int forced)
         if (!forced && !field_funcs[fi->count ? IS_ARRAY : IS_SINGLE].has_changed(field_node))
             continue;
         field_funcs[fi->count ? IS_ARRAY : IS_SINGLE].update_data(s->data + fi->offset, field_node, fi);
-        s->has_changed = 1; // TODO: only re-upload the changing data segments
+        s->dirty_fields[i] = 1;
+        s->has_changed = 1;
     }
 }
 
@@ -338,6 +380,10 @@ static int block_init(struct ngl_node *node)
     if (!s->data)
         return NGL_ERROR_MEMORY;
 
+    s->dirty_fields = ngli_calloc(s->nb_fields, sizeof(*s->dirty_fields));
+    if (!s->dirty_fields)
+        return NGL_ERROR_MEMORY;
+
     update_block_data(s, 1);
     return 0;
 }
@@ -369,6 +415,7 @@ static void block_uninit(struct ngl_node *node)
 
     ngli_block_reset(&s->block);
     ngli_free(s->data);
+    ngli_freep(&s->dirty_fields);
 }
 
 const struct node_class ngli_block_class = {
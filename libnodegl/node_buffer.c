@@ -31,6 +31,7 @@
 #include "memory.h"
 #include "nodegl.h"
 #include "nodes.h"
+#include "sharegroup.h"
 #include "type.h"
 #include "utils.h"
 
@@ -59,16 +60,71 @@ int ngli_node_buffer_ref(struct ngl_node *node)
     if (s->block)
         return ngli_node_block_ref(s->block);
 
-    if (s->buffer_refcount++ == 0) {
-        s->buffer = ngli_buffer_create(gctx);
-        if (!s->buffer)
-            return NGL_ERROR_MEMORY;
+    if (s->buffer_refcount == 0) {
+        /*
+         * File-backed buffers are immutable: with a share context, the GPU
+         * copy is shared between all the nodes of the share group referencing
+         * the same file with the same layout and usage.
+         */
+        if (s->filename && ctx->config.share_ctx) {
+            s->share_key = ngli_asprintf("%d:%d:%d:%s", s->data_format, s->count, s->usage, s->filename);
+            if (!s->share_key)
+                return NGL_ERROR_MEMORY;
+            int ret = ngli_sharegroup_ref_buffer(ctx->sharegroup, gctx, s->share_key, &s->buffer);
+            if (ret < 0) {
+                ngli_freep(&s->share_key);
+                return ret;
+            }
+            s->share_usage = s->usage;
+        } else {
+            s->buffer = ngli_buffer_create(gctx);
+            if (!s->buffer)
+                return NGL_ERROR_MEMORY;
+        }
         s->buffer_last_upload_time = -1.;
+    } else if (s->share_key && (s->usage & ~s->share_usage)) {
+        /* the buffer shared with the previous usage is already in use */
+        LOG(ERROR, "shared buffer %s cannot be used with a different usage (0x%x, previously 0x%x)",
+            s->filename, s->usage, s->share_usage);
+        return NGL_ERROR_UNSUPPORTED;
     }
 
+    s->buffer_refcount++;
     return 0;
 }
 
+static int init_shared_buffer(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct gctx *gctx = ctx->gctx;
+    struct sharegroup *sharegroup = ctx->sharegroup;
+    struct buffer_priv *s = node->priv_data;
+
+    ngli_sharegroup_lock(sharegroup);
+
+    int ret = 0;
+    if (s->buffer->size)
+        goto end;
+
+    /* the buffer may have been created by another context of the share group */
+    s->buffer->gctx = gctx;
+
+    if ((ret = ngli_node_buffer_load_host_data(node)) < 0 ||
+        (ret = ngli_buffer_init(s->buffer, s->data_size, s->usage)) < 0 ||
+        (ret = ngli_buffer_upload(s->buffer, s->data, s->data_size, 0)) < 0)
+        goto end;
+    ngli_buffer_uncharge(s->buffer);
+
+    /* make sure the upload is complete before other contexts use the buffer */
+    ngli_gctx_wait_idle(gctx);
+
+end:
+    ngli_sharegroup_unlock(sharegroup);
+    if (ret >= 0)
+        ngli_node_buffer_release_host_data(node);
+    return ret;
+}
+
 int ngli_node_buffer_init(struct ngl_node *node)
 {
     struct buffer_priv *s = node->priv_data;
@@ -78,17 +134,26 @@ int ngli_node_buffer_init(struct ngl_node *node)
 
     ngli_assert(s->buffer);
 
+    if (s->share_key)
+        return init_shared_buffer(node);
+
     if (s->buffer->size)
         return 0;
 
-    int ret = ngli_buffer_init(s->buffer, s->data_size, s->usage);
+    int ret = ngli_node_buffer_load_host_data(node);
     if (ret < 0)
         return ret;
 
-    ret = ngli_buffer_upload(s->buffer, s->data, s->data_size);
+    ret = ngli_buffer_init(s->buffer, s->data_size, s->usage);
     if (ret < 0)
         return ret;
 
+    ret = ngli_buffer_upload(s->buffer, s->data, s->data_size, 0);
+    if (ret < 0)
+        return ret;
+
+    ngli_node_buffer_release_host_data(node);
+
     return 0;
 }
 
@@ -102,8 +167,16 @@ void ngli_node_buffer_unref(struct ngl_node *node)
     }
 
     ngli_assert(s->buffer_refcount);
-    if (s->buffer_refcount-- == 1)
-        ngli_buffer_freep(&s->buffer);
+    if (s->buffer_refcount-- == 1) {
+        if (s->share_key) {
+            struct ngl_ctx *ctx = node->ctx;
+            ngli_sharegroup_unref_buffer(ctx->sharegroup, ctx->gctx, s->share_key);
+            ngli_freep(&s->share_key);
+            s->buffer = NULL;
+        } else {
+            ngli_buffer_freep(&s->buffer);
+        }
+    }
 }
 
 int ngli_node_buffer_upload(struct ngl_node *node)
@@ -114,7 +187,7 @@ int ngli_node_buffer_upload(struct ngl_node *node)
         return ngli_node_block_upload(s->block);
 
     if (s->dynamic && s->buffer_last_upload_time != node->last_update_time) {
-        int ret = ngli_buffer_upload(s->buffer, s->data, s->data_size);
+        int ret = ngli_buffer_upload(s->buffer, s->data, s->data_size, 0);
         if (ret < 0)
             return ret;
         s->buffer_last_upload_time = node->last_update_time;
@@ -140,6 +213,68 @@ static int buffer_init_from_data(struct ngl_node *node)
     return 0;
 }
 
+static int load_host_data(struct ngl_node *node)
+{
+    struct buffer_priv *s = node->priv_data;
+
+    s->data = ngli_calloc(s->count, s->data_stride);
+    if (!s->data)
+        return NGL_ERROR_MEMORY;
+
+    /*
+     * The data must not be left allocated on failure: a later reload would
+     * otherwise consider it valid
+     */
+    FILE *fp = fopen(s->filename, "rb");
+    if (!fp) {
+        LOG(ERROR, "could not open '%s'", s->filename);
+        ngli_freep(&s->data);
+        return NGL_ERROR_IO;
+    }
+
+    size_t n = fread(s->data, 1, s->data_size, fp);
+    fclose(fp);
+    if (n != s->data_size) {
+        LOG(ERROR, "read %zd bytes does not match expected size of %d bytes", n, s->data_size);
+        ngli_freep(&s->data);
+        return NGL_ERROR_IO;
+    }
+
+    return 0;
+}
+
+int ngli_node_buffer_load_host_data(struct ngl_node *node)
+{
+    struct buffer_priv *s = node->priv_data;
+
+    if (s->data || !s->filename)
+        return 0;
+
+    LOG(DEBUG, "reload host data of %s from '%s'", node->label, s->filename);
+    return load_host_data(node);
+}
+
+void ngli_node_buffer_release_host_data(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct buffer_priv *s = node->priv_data;
+
+    /*
+     * Only file-backed buffers are immutable and can be read again from
+     * their source; the data of the other buffers is owned by the user.
+     */
+    if (!ctx->config.release_host_data || !s->filename || s->host_data_pinned)
+        return;
+
+    ngli_freep(&s->data);
+}
+
+void ngli_node_buffer_pin_host_data(struct ngl_node *node)
+{
+    struct buffer_priv *s = node->priv_data;
+    s->host_data_pinned = 1;
+}
+
 static int buffer_init_from_filename(struct ngl_node *node)
 {
     struct buffer_priv *s = node->priv_data;
@@ -166,25 +301,10 @@ static int buffer_init_from_filename(struct ngl_node *node)
         return NGL_ERROR_INVALID_DATA;
     }
 
-    s->data = ngli_calloc(s->count, s->data_stride);
-    if (!s->data)
-        return NGL_ERROR_MEMORY;
-
-    s->fp = fopen(s->filename, "rb");
-    if (!s->fp) {
-        LOG(ERROR, "could not open '%s'", s->filename);
-        return NGL_ERROR_IO;
-    }
-
-    size_t n = fread(s->data, 1, s->data_size, s->fp);
-    if (n != s->data_size) {
-        LOG(ERROR, "could not read '%s'", s->filename);
-        return NGL_ERROR_IO;
-    }
-
-    if (n != s->data_size) {
-        LOG(ERROR, "read %zd bytes does not match expected size of %d bytes", n, s->data_size);
-        return NGL_ERROR_IO;
+    ret = load_host_data(node);
+    if (ret < 0) {
+        s->data_size = 0;
+        return ret;
     }
 
     return 0;
@@ -276,13 +396,6 @@ static void buffer_uninit(struct ngl_node *node)
     if (s->filename) {
         ngli_freep(&s->data);
         s->data_size = 0;
-
-        if (s->fp) {
-            int ret = fclose(s->fp);
-            if (ret < 0) {
-                LOG(ERROR, "could not properly close '%s'", s->filename);
-            }
-        }
     } else if (s->block) {
         /* Prevent the param API to free a non-owned pointer */
         s->data = NULL;
@@ -49,9 +49,10 @@ struct camera_priv {
     int use_perspective;
     int use_orthographic;
 
-    const float *eye_transform_matrix;
-    const float *center_transform_matrix;
-    const float *up_transform_matrix;
+    int static_transforms;
+    int64_t static_transforms_rev;
+    int view_changed;
+    int projection_changed;
 
     float ground[3];
 
@@ -59,27 +60,47 @@ struct camera_priv {
     NGLI_ALIGNED_MAT(projection_matrix);
 };
 
+static int update_view(struct ngl_node *node)
+{
+    struct camera_priv *s = node->priv_data;
+    s->view_changed = 1;
+    return 0;
+}
+
+static int update_projection(struct ngl_node *node)
+{
+    struct camera_priv *s = node->priv_data;
+    s->projection_changed = 1;
+    return 0;
+}
+
 #define OFFSET(x) offsetof(struct camera_priv, x)
 static const struct node_param camera_params[] = {
     {"child", PARAM_TYPE_NODE, OFFSET(child), .flags=PARAM_FLAG_NON_NULL,
               .desc=NGLI_DOCSTRING("scene to observe through the lens of the camera")},
     {"eye", PARAM_TYPE_VEC3,  OFFSET(eye), {.vec={0.0f, 0.0f, 0.0f}},
             .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE,
+            .update_func=update_view,
             .desc=NGLI_DOCSTRING("eye position")},
     {"center", PARAM_TYPE_VEC3,  OFFSET(center), {.vec={0.0f, 0.0f, -1.0f}},
                .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE,
+               .update_func=update_view,
                .desc=NGLI_DOCSTRING("center position")},
     {"up", PARAM_TYPE_VEC3,  OFFSET(up), {.vec={0.0f, 1.0f, 0.0f}},
            .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE,
+           .update_func=update_view,
            .desc=NGLI_DOCSTRING("up vector")},
     {"perspective", PARAM_TYPE_VEC2,  OFFSET(perspective),
                     .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE,
+                    .update_func=update_projection,
                     .desc=NGLI_DOCSTRING("the 2 following values: *fov*, *aspect*")},
     {"orthographic", PARAM_TYPE_VEC4, OFFSET(orthographic),
                      .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE,
+                     .update_func=update_projection,
                      .desc=NGLI_DOCSTRING("the 4 following values: *left*, *right*, *bottom*, *top*")},
     {"clipping", PARAM_TYPE_VEC2, OFFSET(clipping),
                  .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE,
+                 .update_func=update_projection,
                  .desc=NGLI_DOCSTRING("the 2 following values: *near clipping plane*, *far clipping plane*")},
     {"eye_transform", PARAM_TYPE_NODE, OFFSET(eye_transform),
                      .flags=PARAM_FLAG_DOT_DISPLAY_FIELDNAME,
@@ -123,37 +144,34 @@ static int camera_init(struct ngl_node *node)
         return NGL_ERROR_INVALID_ARG;
     }
 
-    s->eye_transform_matrix    = ngli_get_last_transformation_matrix(s->eye_transform);
-    s->center_transform_matrix = ngli_get_last_transformation_matrix(s->center_transform);
-    s->up_transform_matrix     = ngli_get_last_transformation_matrix(s->up_transform);
+    int ret;
+    if ((ret = ngli_transform_chain_check(s->eye_transform)) < 0 ||
+        (ret = ngli_transform_chain_check(s->center_transform)) < 0 ||
+        (ret = ngli_transform_chain_check(s->up_transform)) < 0)
+        return ret;
+
+    s->static_transforms = ngli_transform_chain_is_static(s->eye_transform) &&
+                           ngli_transform_chain_is_static(s->center_transform) &&
+                           ngli_transform_chain_is_static(s->up_transform);
+
+    s->view_changed = 1;
+    s->projection_changed = 1;
 
     return 0;
 }
 
-static int camera_update(struct ngl_node *node, double t)
+static void update_view_matrix(struct camera_priv *s)
 {
-    struct ngl_ctx *ctx = node->ctx;
-    struct camera_priv *s = node->priv_data;
-    struct ngl_node *child = s->child;
-
     NGLI_ALIGNED_VEC(eye)    = {0.0f, 0.0f, 0.0f, 1.0f};
     NGLI_ALIGNED_VEC(center) = {0.0f, 0.0f, 0.0f, 1.0f};
     NGLI_ALIGNED_VEC(up)     = {0.0f, 0.0f, 0.0f, 1.0f};
-    static const NGLI_ALIGNED_MAT(id_matrix) = NGLI_MAT4_IDENTITY;
 
 #define APPLY_TRANSFORM(what) do {                                          \
     memcpy(what, s->what, sizeof(s->what));                                 \
     if (s->what##_transform) {                                              \
-        int ret = ngli_node_update(s->what##_transform, t);                 \
-        if (ret < 0)                                                        \
-            return ret;                                                     \
-        if (!ngli_darray_push(&ctx->modelview_matrix_stack, id_matrix))     \
-            return NGL_ERROR_MEMORY;                                        \
-        ngli_node_draw(s->what##_transform);                                \
-        ngli_darray_pop(&ctx->modelview_matrix_stack);                      \
-        const float *matrix = s->what##_transform_matrix;                   \
-        if (matrix)                                                         \
-            ngli_mat4_mul_vec4(what, matrix, what);                         \
+        NGLI_ALIGNED_MAT(matrix);                                           \
+        ngli_transform_chain_compute(s->what##_transform, matrix);          \
+        ngli_mat4_mul_vec4(what, matrix, what);                             \
     }                                                                       \
 } while (0)
 
@@ -168,16 +186,10 @@ static int camera_update(struct ngl_node *node, double t)
     }
 
     ngli_mat4_look_at(s->modelview_matrix, eye, center, up);
+}
 
-    if (s->fov_anim) {
-        struct ngl_node *anim_node = s->fov_anim;
-        struct variable_priv *anim = anim_node->priv_data;
-        int ret = ngli_node_update(anim_node, t);
-        if (ret < 0)
-            return ret;
-        s->perspective[0] = anim->scalar;
-    }
-
+static void update_projection_matrix(struct gctx *gctx, struct camera_priv *s)
+{
     if (s->use_perspective) {
         ngli_mat4_perspective(s->projection_matrix,
                               s->perspective[0],
@@ -196,8 +208,56 @@ static int camera_update(struct ngl_node *node, double t)
         ngli_mat4_identity(s->projection_matrix);
     }
 
-    struct gctx *gctx = ctx->gctx;
     ngli_gctx_transform_projection_matrix(gctx, s->projection_matrix);
+}
+
+static int camera_update(struct ngl_node *node, double t)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct camera_priv *s = node->priv_data;
+    struct ngl_node *child = s->child;
+
+    /*
+     * The matrices are only recomputed when their inputs change: live
+     * changes of the camera parameters, animated transforms, live changes of
+     * static transforms, or a new field of view.
+     */
+    if (!s->static_transforms) {
+        struct ngl_node *transforms[] = {s->eye_transform, s->center_transform, s->up_transform};
+        for (int i = 0; i < NGLI_ARRAY_NB(transforms); i++) {
+            if (!transforms[i])
+                continue;
+            int ret = ngli_node_update(transforms[i], t);
+            if (ret < 0)
+                return ret;
+        }
+        s->view_changed = 1;
+    } else if (s->static_transforms_rev != ctx->static_transforms_rev) {
+        s->static_transforms_rev = ctx->static_transforms_rev;
+        s->view_changed = 1;
+    }
+
+    if (s->view_changed) {
+        update_view_matrix(s);
+        s->view_changed = 0;
+    }
+
+    if (s->fov_anim) {
+        struct ngl_node *anim_node = s->fov_anim;
+        struct variable_priv *anim = anim_node->priv_data;
+        int ret = ngli_node_update(anim_node, t);
+        if (ret < 0)
+            return ret;
+        if (s->perspective[0] != anim->scalar) {
+            s->perspective[0] = anim->scalar;
+            s->projection_changed = 1;
+        }
+    }
+
+    if (s->projection_changed) {
+        update_projection_matrix(ctx->gctx, s);
+        s->projection_changed = 0;
+    }
 
     return ngli_node_update(child, t);
 }
@@ -48,6 +48,12 @@ static int circle_init(struct ngl_node *node)
         LOG(ERROR, "invalid number of points (%d < 3)", s->npoints);
         return NGL_ERROR_INVALID_ARG;
     }
+    s->topology = NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    ret = ngli_node_geometry_cache_ref(node);
+    if (ret != 0)
+        return NGLI_MIN(ret, 0);
+
     const int nb_vertices = s->npoints + 1;
     const int nb_indices  = s->npoints * 3;
 
@@ -116,7 +122,7 @@ static int circle_init(struct ngl_node *node)
         goto end;
     }
 
-    s->topology = NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    ret = ngli_node_geometry_cache_add(node);
 
 end:
     ngli_free(vertices);
@@ -126,21 +132,9 @@ end:
     return ret;
 }
 
-#define NODE_UNREFP(node) do {                    \
-    if (node) {                                   \
-        ngli_node_detach_ctx(node, node->ctx);    \
-        ngl_node_unrefp(&node);                   \
-    }                                             \
-} while (0)
-
 static void circle_uninit(struct ngl_node *node)
 {
-    struct geometry_priv *s = node->priv_data;
-
-    NODE_UNREFP(s->vertices_buffer);
-    NODE_UNREFP(s->uvcoords_buffer);
-    NODE_UNREFP(s->normals_buffer);
-    NODE_UNREFP(s->indices_buffer);
+    ngli_node_geometry_cache_unref(node);
 }
 
 const struct node_class ngli_circle_class = {
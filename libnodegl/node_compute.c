@@ -141,6 +141,8 @@ static void compute_uninit(struct ngl_node *node)
 static int compute_update(struct ngl_node *node, double t)
 {
     struct compute_priv *s = node->priv_data;
+    // The outputs of a compute may depend on its previous outputs
+    node->ctx->frame_changed = 1;
     return ngli_pass_update(&s->pass, t);
 }
 
@@ -24,7 +24,12 @@
 #include <string.h>
 #include <stdint.h>
 
+#include "bstr.h"
+#include "gctx.h"
+#include "hmap.h"
 #include "log.h"
+#include "memory.h"
+#include "meshopt.h"
 #include "nodegl.h"
 #include "nodes.h"
 #include "topology.h"
@@ -56,6 +61,165 @@ fail:
     return NULL;
 }
 
+struct cached_geometry {
+    int refcount;
+    struct ngl_node *vertices_buffer;
+    struct ngl_node *uvcoords_buffer;
+    struct ngl_node *normals_buffer;
+    struct ngl_node *indices_buffer;
+};
+
+#define NODE_UNREFP(node) do {                    \
+    if (node) {                                   \
+        ngli_node_detach_ctx(node, node->ctx);    \
+        ngl_node_unrefp(&node);                   \
+    }                                             \
+} while (0)
+
+static void free_cached_geometry(void *user_arg, void *data)
+{
+    struct cached_geometry *cached = data;
+    NODE_UNREFP(cached->vertices_buffer);
+    NODE_UNREFP(cached->uvcoords_buffer);
+    NODE_UNREFP(cached->normals_buffer);
+    NODE_UNREFP(cached->indices_buffer);
+    ngli_free(cached);
+}
+
+static void print_floats(struct bstr *b, const float *values, int nb_values)
+{
+    for (int i = 0; i < nb_values; i++)
+        ngli_bstr_printf(b, ":%.9g", values[i]);
+}
+
+static char *get_cache_key(const struct ngl_node *node)
+{
+    const struct geometry_priv *s = node->priv_data;
+
+    struct bstr *b = ngli_bstr_create();
+    if (!b)
+        return NULL;
+
+    ngli_bstr_print(b, node->class->name);
+    switch (node->class->id) {
+    case NGL_NODE_CIRCLE:
+        ngli_bstr_printf(b, ":%.17g:%d", s->radius, s->npoints);
+        break;
+    case NGL_NODE_QUAD:
+        print_floats(b, s->quad_corner,    NGLI_ARRAY_NB(s->quad_corner));
+        print_floats(b, s->quad_width,     NGLI_ARRAY_NB(s->quad_width));
+        print_floats(b, s->quad_height,    NGLI_ARRAY_NB(s->quad_height));
+        print_floats(b, s->quad_uv_corner, NGLI_ARRAY_NB(s->quad_uv_corner));
+        print_floats(b, s->quad_uv_width,  NGLI_ARRAY_NB(s->quad_uv_width));
+        print_floats(b, s->quad_uv_height, NGLI_ARRAY_NB(s->quad_uv_height));
+        break;
+    case NGL_NODE_TRIANGLE:
+        print_floats(b, s->triangle_edges, NGLI_ARRAY_NB(s->triangle_edges));
+        print_floats(b, s->triangle_uvs,   NGLI_ARRAY_NB(s->triangle_uvs));
+        break;
+    default:
+        ngli_assert(0);
+    }
+
+    char *key = ngli_bstr_strdup(b);
+    ngli_bstr_freep(&b);
+    return key;
+}
+
+int ngli_node_geometry_cache_ref(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct geometry_priv *s = node->priv_data;
+
+    char *key = get_cache_key(node);
+    if (!key)
+        return NGL_ERROR_MEMORY;
+
+    struct cached_geometry *cached = ctx->geometry_cache ? ngli_hmap_get(ctx->geometry_cache, key) : NULL;
+    if (!cached) {
+        ngli_free(key);
+        return 0;
+    }
+
+    cached->refcount++;
+    s->cache_key       = key;
+    s->vertices_buffer = cached->vertices_buffer;
+    s->uvcoords_buffer = cached->uvcoords_buffer;
+    s->normals_buffer  = cached->normals_buffer;
+    s->indices_buffer  = cached->indices_buffer;
+    return 1;
+}
+
+int ngli_node_geometry_cache_add(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct geometry_priv *s = node->priv_data;
+
+    if (!ctx->geometry_cache) {
+        ctx->geometry_cache = ngli_hmap_create();
+        if (!ctx->geometry_cache)
+            return NGL_ERROR_MEMORY;
+        ngli_hmap_set_free(ctx->geometry_cache, free_cached_geometry, NULL);
+    }
+
+    char *key = get_cache_key(node);
+    if (!key)
+        return NGL_ERROR_MEMORY;
+
+    struct cached_geometry *cached = ngli_calloc(1, sizeof(*cached));
+    if (!cached) {
+        ngli_free(key);
+        return NGL_ERROR_MEMORY;
+    }
+
+    *cached = (struct cached_geometry){
+        .refcount        = 1,
+        .vertices_buffer = s->vertices_buffer,
+        .uvcoords_buffer = s->uvcoords_buffer,
+        .normals_buffer  = s->normals_buffer,
+        .indices_buffer  = s->indices_buffer,
+    };
+
+    int ret = ngli_hmap_set(ctx->geometry_cache, key, cached);
+    if (ret < 0) {
+        ngli_free(cached);
+        ngli_free(key);
+        return ret;
+    }
+
+    /* the buffers are now owned by the cache */
+    s->cache_key = key;
+    return 0;
+}
+
+void ngli_node_geometry_cache_unref(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct geometry_priv *s = node->priv_data;
+
+    if (!s->cache_key) {
+        NODE_UNREFP(s->vertices_buffer);
+        NODE_UNREFP(s->uvcoords_buffer);
+        NODE_UNREFP(s->normals_buffer);
+        NODE_UNREFP(s->indices_buffer);
+        return;
+    }
+
+    struct cached_geometry *cached = ngli_hmap_get(ctx->geometry_cache, s->cache_key);
+    ngli_assert(cached && cached->refcount);
+    if (--cached->refcount == 0) {
+        ngli_hmap_set(ctx->geometry_cache, s->cache_key, NULL);
+        if (!ngli_hmap_count(ctx->geometry_cache))
+            ngli_hmap_freep(&ctx->geometry_cache);
+    }
+
+    s->vertices_buffer = NULL;
+    s->uvcoords_buffer = NULL;
+    s->normals_buffer  = NULL;
+    s->indices_buffer  = NULL;
+    ngli_freep(&s->cache_key);
+}
+
 static const struct param_choices topology_choices = {
     .name = "topology",
     .consts = {
@@ -68,6 +232,17 @@ static const struct param_choices topology_choices = {
     }
 };
 
+static const struct param_choices optimize_choices = {
+    .name = "geometry_optimizations",
+    .consts = {
+        {"vertex_cache", NGLI_GEOMETRY_OPTIMIZE_VERTEX_CACHE, .desc=NGLI_DOCSTRING("reorder the triangles for post-transform vertex cache locality")},
+        {"overdraw",     NGLI_GEOMETRY_OPTIMIZE_OVERDRAW,     .desc=NGLI_DOCSTRING("reorder the triangle clusters to reduce overdraw")},
+        {"vertex_fetch", NGLI_GEOMETRY_OPTIMIZE_VERTEX_FETCH, .desc=NGLI_DOCSTRING("reorder the vertices in their order of use for fetch locality")},
+        {"strip",        NGLI_GEOMETRY_OPTIMIZE_STRIP,        .desc=NGLI_DOCSTRING("draw the non-dynamic indices as triangle strips separated by primitive restart indices if supported")},
+        {NULL}
+    }
+};
+
 #define TEXCOORDS_TYPES_LIST (const int[]){NGL_NODE_BUFFERFLOAT,            \
                                            NGL_NODE_BUFFERVEC2,             \
                                            NGL_NODE_BUFFERVEC3,             \
@@ -97,6 +272,11 @@ static const struct node_param geometry_params[] = {
     {"topology",  PARAM_TYPE_SELECT, OFFSET(topology), {.i64=NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST},
                   .choices=&topology_choices,
                   .desc=NGLI_DOCSTRING("primitive topology")},
+    {"optimize",  PARAM_TYPE_FLAGS, OFFSET(optimize),
+                  .choices=&optimize_choices,
+                  .desc=NGLI_DOCSTRING("mesh optimizations applied once at init to an indexed `triangle_list`; "
+                                       "the buffers are modified in place and must not be shared with other geometries, "
+                                       "the triangle order changes which matters with blending")},
     {NULL}
 };
 
@@ -108,6 +288,216 @@ static const struct node_param geometry_params[] = {
     }                                                      \
 } while (0)                                                \
 
+static int check_static_buffer(const struct ngl_node *node, const char *name)
+{
+    const struct buffer_priv *s = node->priv_data;
+    if (s->dynamic || s->filename || s->block) {
+        LOG(ERROR, "%s buffer %s must hold static in-memory data to be optimized", name, node->label);
+        return NGL_ERROR_INVALID_ARG;
+    }
+    return 0;
+}
+
+#define CONVERT_INDICES(dst_type, dst, src_type, src, count) do { \
+    const src_type *src_data = (const src_type *)(src);          \
+    dst_type *dst_data = (dst_type *)(dst);                      \
+    for (int i = 0; i < (count); i++)                            \
+        dst_data[i] = src_data[i];                               \
+} while (0)
+
+static int optimize_buffers(struct ngl_node *node, uint32_t *indices, uint32_t *tmp)
+{
+    struct geometry_priv *s = node->priv_data;
+    struct buffer_priv *vertices = s->vertices_buffer->priv_data;
+    const struct buffer_priv *indices_buffer_priv = s->indices_buffer->priv_data;
+    const int nb_indices = indices_buffer_priv->count;
+    const int nb_vertices = vertices->count;
+
+    int ret;
+    if (s->optimize & NGLI_GEOMETRY_OPTIMIZE_VERTEX_CACHE) {
+        ret = ngli_meshopt_optimize_vertex_cache(tmp, indices, nb_indices, nb_vertices);
+        if (ret < 0)
+            return ret;
+        memcpy(indices, tmp, nb_indices * sizeof(*indices));
+    }
+
+    if (s->optimize & NGLI_GEOMETRY_OPTIMIZE_OVERDRAW) {
+        if ((ret = check_static_buffer(s->vertices_buffer, "vertices")) < 0)
+            return ret;
+        const float *positions = (const float *)vertices->data;
+        ret = ngli_meshopt_optimize_overdraw(tmp, indices, nb_indices, positions, nb_vertices);
+        if (ret < 0)
+            return ret;
+        memcpy(indices, tmp, nb_indices * sizeof(*indices));
+    }
+
+    if (s->optimize & NGLI_GEOMETRY_OPTIMIZE_VERTEX_FETCH) {
+        struct ngl_node *buffers[] = {s->vertices_buffer, s->uvcoords_buffer, s->normals_buffer};
+        const char *names[] = {"vertices", "uvcoords", "normals"};
+        for (int i = 0; i < NGLI_ARRAY_NB(buffers); i++) {
+            if (buffers[i] && (ret = check_static_buffer(buffers[i], names[i])) < 0)
+                return ret;
+        }
+
+        uint32_t *remap = ngli_calloc(nb_vertices, sizeof(*remap));
+        if (!remap)
+            return NGL_ERROR_MEMORY;
+        ret = ngli_meshopt_optimize_vertex_fetch(remap, indices, nb_indices, nb_vertices);
+        for (int i = 0; ret >= 0 && i < NGLI_ARRAY_NB(buffers); i++) {
+            if (!buffers[i])
+                continue;
+            struct buffer_priv *buffer = buffers[i]->priv_data;
+            ret = ngli_meshopt_remap_vertices(buffer->data, buffer->count, buffer->data_stride, remap);
+        }
+        ngli_free(remap);
+        if (ret < 0)
+            return ret;
+    }
+
+    return 0;
+}
+
+static int optimize_geometry(struct ngl_node *node)
+{
+    struct geometry_priv *s = node->priv_data;
+
+    if (s->topology != NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST || !s->indices_buffer) {
+        LOG(ERROR, "mesh optimizations are only supported with indexed triangle lists");
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    int ret = check_static_buffer(s->indices_buffer, "indices");
+    if (ret < 0)
+        return ret;
+
+    struct buffer_priv *indices_buffer_priv = s->indices_buffer->priv_data;
+    const struct buffer_priv *vertices = s->vertices_buffer->priv_data;
+    const int nb_indices = indices_buffer_priv->count;
+
+    uint32_t *indices = ngli_calloc(nb_indices, sizeof(*indices));
+    uint32_t *tmp = ngli_calloc(nb_indices, sizeof(*tmp));
+    if (!indices || !tmp) {
+        ret = NGL_ERROR_MEMORY;
+        goto end;
+    }
+
+    const int is_ushort = indices_buffer_priv->data_format == NGLI_FORMAT_R16_UNORM;
+    if (is_ushort)
+        CONVERT_INDICES(uint32_t, indices, uint16_t, indices_buffer_priv->data, nb_indices);
+    else
+        memcpy(indices, indices_buffer_priv->data, nb_indices * sizeof(*indices));
+
+    const int misses_before = ngli_meshopt_get_cache_misses(indices, nb_indices, vertices->count,
+                                                            NGLI_MESHOPT_CACHE_SIZE);
+    if (misses_before < 0) {
+        LOG(ERROR, "%s indices must form triangles referencing the %d vertices",
+            node->label, vertices->count);
+        ret = misses_before;
+        goto end;
+    }
+
+    ret = optimize_buffers(node, indices, tmp);
+    if (ret < 0)
+        goto end;
+
+    if (is_ushort)
+        CONVERT_INDICES(uint16_t, indices_buffer_priv->data, uint32_t, indices, nb_indices);
+    else
+        memcpy(indices_buffer_priv->data, indices, nb_indices * sizeof(*indices));
+
+    const int nb_triangles = nb_indices / 3;
+    const int misses_after = ngli_meshopt_get_cache_misses(indices, nb_indices, vertices->count,
+                                                           NGLI_MESHOPT_CACHE_SIZE);
+    if (nb_triangles)
+        LOG(DEBUG, "%s: ACMR %.3f -> %.3f", node->label,
+            misses_before / (float)nb_triangles, misses_after / (float)nb_triangles);
+
+end:
+    ngli_free(tmp);
+    ngli_free(indices);
+    return ret;
+}
+
+/*
+ * The indices used for drawing are narrowed to 16 bits whenever their values
+ * allow it, and the triangle lists are optionally converted to strips
+ * separated by primitive restart indices, using the maximum value of the
+ * index type. Primitive restart is only enabled for the draws of these
+ * strips. The source indices are left untouched, so they can be file-backed.
+ */
+static int pack_indices(struct ngl_node *node)
+{
+    struct geometry_priv *s = node->priv_data;
+    const struct buffer_priv *indices_buffer_priv = s->indices_buffer->priv_data;
+    const int nb_indices = indices_buffer_priv->count;
+
+    if (indices_buffer_priv->dynamic || indices_buffer_priv->block || !indices_buffer_priv->data)
+        return 0;
+
+    const int is_ushort = s->max_indices < UINT16_MAX;
+    const int narrow = is_ushort && indices_buffer_priv->data_format == NGLI_FORMAT_R32_UINT;
+    int to_strip = (s->optimize & NGLI_GEOMETRY_OPTIMIZE_STRIP) && nb_indices % 3 == 0;
+    if (to_strip && !(node->ctx->gctx->features & NGLI_FEATURE_PRIMITIVE_RESTART_FIXED_INDEX)) {
+        LOG(WARNING, "primitive restart is not supported, %s is drawn as a triangle list", node->label);
+        to_strip = 0;
+    }
+    if (!narrow && !to_strip)
+        return 0;
+
+    int ret = 0;
+    uint16_t *narrowed = NULL;
+    uint32_t *indices = ngli_calloc(nb_indices, sizeof(*indices));
+    uint32_t *strip = to_strip ? ngli_calloc(nb_indices / 3 * 4, sizeof(*strip)) : NULL;
+    if (!indices || (to_strip && !strip)) {
+        ret = NGL_ERROR_MEMORY;
+        goto end;
+    }
+
+    if (indices_buffer_priv->data_format == NGLI_FORMAT_R16_UNORM)
+        CONVERT_INDICES(uint32_t, indices, uint16_t, indices_buffer_priv->data, nb_indices);
+    else
+        memcpy(indices, indices_buffer_priv->data, nb_indices * sizeof(*indices));
+
+    const uint32_t *packed = indices;
+    int nb_packed = nb_indices;
+    s->packed_topology = s->topology;
+    if (to_strip) {
+        const uint32_t restart_index = is_ushort ? UINT16_MAX : UINT32_MAX;
+        const int nb_strip_indices = ngli_meshopt_convert_to_strip(strip, indices, nb_indices, restart_index);
+        LOG(DEBUG, "%s: %d strip indices for %d list indices", node->label, nb_strip_indices, nb_indices);
+        if (nb_strip_indices < nb_indices) {
+            packed = strip;
+            nb_packed = nb_strip_indices;
+            s->packed_topology = NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+            s->primitive_restart = 1;
+        } else if (!narrow) {
+            goto end;
+        }
+    }
+
+    if (is_ushort) {
+        narrowed = ngli_calloc(nb_packed, sizeof(*narrowed));
+        if (!narrowed) {
+            ret = NGL_ERROR_MEMORY;
+            goto end;
+        }
+        CONVERT_INDICES(uint16_t, narrowed, uint32_t, packed, nb_packed);
+        s->packed_indices_buffer = ngli_node_geometry_generate_buffer(node->ctx, NGL_NODE_BUFFERUSHORT, nb_packed,
+                                                                      nb_packed * sizeof(*narrowed), narrowed);
+    } else {
+        s->packed_indices_buffer = ngli_node_geometry_generate_buffer(node->ctx, NGL_NODE_BUFFERUINT, nb_packed,
+                                                                      nb_packed * sizeof(uint32_t), (void *)packed);
+    }
+    if (!s->packed_indices_buffer)
+        ret = NGL_ERROR_MEMORY;
+
+end:
+    ngli_free(narrowed);
+    ngli_free(strip);
+    ngli_free(indices);
+    return ret;
+}
+
 static int geometry_init(struct ngl_node *node)
 {
     struct geometry_priv *s = node->priv_data;
@@ -136,6 +526,19 @@ static int geometry_init(struct ngl_node *node)
         }
     }
 
+    if ((s->optimize & NGLI_GEOMETRY_OPTIMIZE_STRIP) &&
+        (s->topology != NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST || !s->indices_buffer)) {
+        LOG(ERROR, "strip conversion is only supported with indexed triangle lists");
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    /* the strip conversion does not alter the source indices */
+    if (s->optimize & ~NGLI_GEOMETRY_OPTIMIZE_STRIP) {
+        int ret = optimize_geometry(node);
+        if (ret < 0)
+            return ret;
+    }
+
     if (s->indices_buffer) {
         const struct buffer_priv *indices_buffer_priv = s->indices_buffer->priv_data;
         switch (indices_buffer_priv->data_format) {
@@ -144,15 +547,27 @@ static int geometry_init(struct ngl_node *node)
         default:
             ngli_assert(0);
         }
+
+        int ret = pack_indices(node);
+        if (ret < 0)
+            return ret;
     }
 
     return 0;
 }
 
+static void geometry_uninit(struct ngl_node *node)
+{
+    struct geometry_priv *s = node->priv_data;
+
+    NODE_UNREFP(s->packed_indices_buffer);
+}
+
 const struct node_class ngli_geometry_class = {
     .id        = NGL_NODE_GEOMETRY,
     .name      = "Geometry",
     .init      = geometry_init,
+    .uninit    = geometry_uninit,
     .priv_size = sizeof(struct geometry_priv),
     .params    = geometry_params,
     .file      = __FILE__,
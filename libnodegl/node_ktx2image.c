@@ -0,0 +1,74 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stddef.h>
+
+#include "ktx2.h"
+#include "nodegl.h"
+#include "nodes.h"
+
+#define OFFSET(x) offsetof(struct ktx2image_priv, x)
+static const struct node_param ktx2image_params[] = {
+    {"filename", PARAM_TYPE_STR, OFFSET(filename), {.str=NULL}, PARAM_FLAG_NON_NULL,
+                 .desc=NGLI_DOCSTRING("path to the KTX2 file (BC1/BC3/BC7, ETC2, ASTC 4x4 or uncompressed data)")},
+    {NULL}
+};
+
+int ngli_node_ktx2image_load(struct ngl_node *node)
+{
+    struct ktx2image_priv *s = node->priv_data;
+    if (s->ktx2.file_data)
+        return 0;
+    int ret = ngli_ktx2_load(&s->ktx2, s->filename);
+    if (ret < 0)
+        ngli_ktx2_reset(&s->ktx2);
+    return ret;
+}
+
+void ngli_node_ktx2image_release(struct ngl_node *node)
+{
+    struct ktx2image_priv *s = node->priv_data;
+    ngli_ktx2_reset(&s->ktx2);
+}
+
+/*
+ * The file is loaded at init to be validated early, and released by the
+ * textures once uploaded; it is loaded again if they are prefetched again
+ */
+static int ktx2image_init(struct ngl_node *node)
+{
+    return ngli_node_ktx2image_load(node);
+}
+
+static void ktx2image_uninit(struct ngl_node *node)
+{
+    ngli_node_ktx2image_release(node);
+}
+
+const struct node_class ngli_ktx2image_class = {
+    .id        = NGL_NODE_KTX2IMAGE,
+    .name      = "KTX2Image",
+    .init      = ktx2image_init,
+    .uninit    = ktx2image_uninit,
+    .priv_size = sizeof(struct ktx2image_priv),
+    .params    = ktx2image_params,
+    .file      = __FILE__,
+};
@@ -293,6 +293,7 @@ static int media_update(struct ngl_node *node, double t)
         }
         TRACE("got frame %dx%d %s with ts=%f", frame->width, frame->height,
               pix_fmt_str, frame->ts);
+        node->ctx->frame_changed = 1;
     }
     s->frame = frame;
     return 0;
@@ -60,6 +60,12 @@ static int quad_init(struct ngl_node *node)
 {
     struct geometry_priv *s = node->priv_data;
 
+    s->topology = NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
+
+    int ret = ngli_node_geometry_cache_ref(node);
+    if (ret != 0)
+        return NGLI_MIN(ret, 0);
+
     const float vertices[] = {
         C(0),               C(1),               C(2),
         C(0) + W(0),        C(1) + W(1),        C(2) + W(2),
@@ -104,25 +110,12 @@ static int quad_init(struct ngl_node *node)
     if (!s->normals_buffer)
         return NGL_ERROR_MEMORY;
 
-    s->topology = NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
-
-    return 0;
+    return ngli_node_geometry_cache_add(node);
 }
 
-#define NODE_UNREFP(node) do {                    \
-    if (node) {                                   \
-        ngli_node_detach_ctx(node, node->ctx);    \
-        ngl_node_unrefp(&node);                   \
-    }                                             \
-} while (0)
-
 static void quad_uninit(struct ngl_node *node)
 {
-    struct geometry_priv *s = node->priv_data;
-
-    NODE_UNREFP(s->vertices_buffer);
-    NODE_UNREFP(s->uvcoords_buffer);
-    NODE_UNREFP(s->normals_buffer);
+    ngli_node_geometry_cache_unref(node);
 }
 
 const struct node_class ngli_quad_class = {
@@ -109,6 +109,22 @@ struct render_priv {
                                             NGL_NODE_BUFFERMAT4,    \
                                             -1}
 
+#define INSTANCE_ATTRIBUTES_TYPES_LIST (const int[]){NGL_NODE_BUFFERFLOAT,           \
+                                                     NGL_NODE_BUFFERVEC2,            \
+                                                     NGL_NODE_BUFFERVEC3,            \
+                                                     NGL_NODE_BUFFERVEC4,            \
+                                                     NGL_NODE_BUFFERMAT4,            \
+                                                     NGL_NODE_ANIMATEDBUFFERFLOAT,   \
+                                                     NGL_NODE_ANIMATEDBUFFERVEC2,    \
+                                                     NGL_NODE_ANIMATEDBUFFERVEC3,    \
+                                                     NGL_NODE_ANIMATEDBUFFERVEC4,    \
+                                                     NGL_NODE_STREAMEDBUFFERFLOAT,   \
+                                                     NGL_NODE_STREAMEDBUFFERVEC2,    \
+                                                     NGL_NODE_STREAMEDBUFFERVEC3,    \
+                                                     NGL_NODE_STREAMEDBUFFERVEC4,    \
+                                                     NGL_NODE_STREAMEDBUFFERMAT4,    \
+                                                     -1}
+
 #define GEOMETRY_TYPES_LIST (const int[]){NGL_NODE_CIRCLE,          \
                                           NGL_NODE_GEOMETRY,        \
                                           NGL_NODE_QUAD,            \
@@ -133,8 +149,9 @@ static const struct node_param render_params[] = {
                  .node_types=ATTRIBUTES_TYPES_LIST,
                  .desc=NGLI_DOCSTRING("extra vertex attributes made accessible to the `program`")},
     {"instance_attributes", PARAM_TYPE_NODEDICT, OFFSET(instance_attributes),
-                 .node_types=ATTRIBUTES_TYPES_LIST,
-                 .desc=NGLI_DOCSTRING("per instance extra vertex attributes made accessible to the `program`")},
+                 .node_types=INSTANCE_ATTRIBUTES_TYPES_LIST,
+                 .desc=NGLI_DOCSTRING("per instance extra vertex attributes made accessible to the `program`; "
+                                      "the animated and streamed buffers are streamed through a ring of GPU buffers")},
     {"nb_instances", PARAM_TYPE_INT, OFFSET(nb_instances), {.i64 = 1},
                  .desc=NGLI_DOCSTRING("number of instances to draw")},
     {NULL}
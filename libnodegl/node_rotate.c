@@ -70,6 +70,7 @@ static int rotate_init(struct ngl_node *node)
     ngli_vec3_norm(s->normed_axis, s->axis);
     if (!s->anim)
         update_trf_matrix(node, s->angle);
+    ngli_transform_set_static(node, !s->anim);
     return 0;
 }
 
@@ -81,6 +82,7 @@ static int update_angle(struct ngl_node *node)
         return NGL_ERROR_INVALID_USAGE;
     }
     update_trf_matrix(node, s->angle);
+    ngli_transform_invalidate_static(node);
     return 0;
 }
 
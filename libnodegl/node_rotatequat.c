@@ -62,6 +62,7 @@ static int rotatequat_init(struct ngl_node *node)
     s->use_anchor = memcmp(s->anchor, zvec, sizeof(zvec));
     if (!s->anim)
         update_trf_matrix(node, s->quat);
+    ngli_transform_set_static(node, !s->anim);
     return 0;
 }
 
@@ -73,6 +74,7 @@ static int update_quat(struct ngl_node *node)
         return NGL_ERROR_INVALID_USAGE;
     }
     update_trf_matrix(node, s->quat);
+    ngli_transform_invalidate_static(node);
     return 0;
 }
 
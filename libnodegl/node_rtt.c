@@ -53,6 +53,9 @@ struct rtt_priv {
     struct texture *ms_colors[NGLI_MAX_COLOR_ATTACHMENTS];
     int nb_ms_colors;
     struct texture *ms_depth;
+
+    int nb_hoisted; // draws of the node already done ahead of the parent pass
+    struct darray subtree_textures; // texture nodes referenced by the subtree of the child
 };
 
 #define FEATURE_DEPTH       (1 << 0)
@@ -89,10 +92,38 @@ static const struct node_param rtt_params[] = {
     {NULL}
 };
 
+static int collect_subtree_textures(struct darray *textures, const struct ngl_node *node)
+{
+    if (node->class->id == NGL_NODE_TEXTURE2D ||
+        node->class->id == NGL_NODE_TEXTURE3D ||
+        node->class->id == NGL_NODE_TEXTURECUBE) {
+        const struct ngl_node **elems = ngli_darray_data(textures);
+        for (int i = 0; i < ngli_darray_count(textures); i++)
+            if (elems[i] == node)
+                return 0;
+        if (!ngli_darray_push(textures, &node))
+            return NGL_ERROR_MEMORY;
+    }
+
+    const struct ngl_node **children = ngli_darray_data(&node->children);
+    for (int i = 0; i < ngli_darray_count(&node->children); i++) {
+        int ret = collect_subtree_textures(textures, children[i]);
+        if (ret < 0)
+            return ret;
+    }
+    return 0;
+}
+
 static int rtt_init(struct ngl_node *node)
 {
     struct rtt_priv *s = node->priv_data;
 
+    /* used to decide if the node can be drawn ahead of an enclosing pass */
+    ngli_darray_init(&s->subtree_textures, sizeof(struct ngl_node *), 0);
+    int ret = collect_subtree_textures(&s->subtree_textures, s->child);
+    if (ret < 0)
+        return ret;
+
     for (int i = 0; i < s->nb_color_textures; i++) {
         const struct texture_priv *texture_priv = s->color_textures[i]->priv_data;
         if (texture_priv->data_src) {
@@ -402,7 +433,7 @@ static int rtt_update(struct ngl_node *node, double t)
     return 0;
 }
 
-static void rtt_draw(struct ngl_node *node)
+static void draw_rtt(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
     struct gctx *gctx = ctx->gctx;
@@ -430,6 +461,10 @@ static void rtt_draw(struct ngl_node *node)
     ctx->current_rendertarget = s->available_rendertargets[0];
     ctx->begin_render_pass = 1;
 
+    struct ngl_node *prev_hoist_rtt = ctx->hoist_rtt;
+    ctx->hoist_rtt = node;
+    ngli_node_draw_hoisted(s->child);
+    ctx->hoist_rtt = prev_hoist_rtt;
     ngli_node_draw(s->child);
 
     if (ctx->begin_render_pass) {
@@ -448,11 +483,77 @@ static void rtt_draw(struct ngl_node *node)
     for (int i = 0; i < s->nb_color_textures; i++) {
         struct texture_priv *texture_priv = s->color_textures[i]->priv_data;
         struct texture *texture = texture_priv->texture;
-        if (ngli_texture_has_mipmap(texture))
-            ngli_texture_generate_mipmap(texture);
+        ngli_texture_invalidate_mipmap(texture);
     }
 }
 
+static int is_read_by_skipped_draws(const struct ngl_ctx *ctx, const struct rtt_priv *s)
+{
+    struct ngl_node **reads = ngli_darray_data(&ctx->hoist_reads);
+    for (int i = 0; i < ngli_darray_count(&ctx->hoist_reads); i++) {
+        for (int j = 0; j < s->nb_color_textures; j++)
+            if (reads[i] == s->color_textures[j])
+                return 1;
+        if (reads[i] == s->depth_texture)
+            return 1;
+    }
+    return 0;
+}
+
+/*
+ * Drawn ahead of the enclosing pass, the subtree would sample the targets of
+ * that pass before they are rendered
+ */
+static int reads_enclosing_targets(const struct ngl_ctx *ctx, const struct rtt_priv *s)
+{
+    if (!ctx->hoist_rtt)
+        return 0;
+
+    const struct rtt_priv *enclosing = ctx->hoist_rtt->priv_data;
+    struct ngl_node **textures = ngli_darray_data(&s->subtree_textures);
+    for (int i = 0; i < ngli_darray_count(&s->subtree_textures); i++) {
+        for (int j = 0; j < enclosing->nb_color_textures; j++)
+            if (textures[i] == enclosing->color_textures[j])
+                return 1;
+        if (textures[i] == enclosing->depth_texture)
+            return 1;
+    }
+    return 0;
+}
+
+static void rtt_draw(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct rtt_priv *s = node->priv_data;
+
+    if (ctx->hoist_passes) {
+        if (ctx->hoist_barrier || is_read_by_skipped_draws(ctx, s) ||
+            reads_enclosing_targets(ctx, s)) {
+            /* preserve the order with the following RenderToTexture */
+            ctx->hoist_barrier = 1;
+            return;
+        }
+        ctx->hoist_passes = 0;
+        draw_rtt(node);
+        ctx->hoist_passes = 1;
+        s->nb_hoisted++;
+        return;
+    }
+
+    if (s->nb_hoisted) {
+        s->nb_hoisted--;
+        return;
+    }
+
+    draw_rtt(node);
+}
+
+static void rtt_uninit(struct ngl_node *node)
+{
+    struct rtt_priv *s = node->priv_data;
+    ngli_darray_reset(&s->subtree_textures);
+}
+
 static void rtt_release(struct ngl_node *node)
 {
     struct rtt_priv *s = node->priv_data;
@@ -472,6 +573,7 @@ const struct node_class ngli_rtt_class = {
     .name      = "RenderToTexture",
     .init      = rtt_init,
     .prepare   = rtt_prepare,
+    .uninit    = rtt_uninit,
     .prefetch  = rtt_prefetch,
     .update    = rtt_update,
     .draw      = rtt_draw,
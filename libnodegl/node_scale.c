@@ -61,6 +61,7 @@ static int scale_init(struct ngl_node *node)
     s->use_anchor = memcmp(s->anchor, zero_anchor, sizeof(s->anchor));
     if (!s->anim)
         update_trf_matrix(node, s->factors);
+    ngli_transform_set_static(node, !s->anim);
     return 0;
 }
 
@@ -72,6 +73,7 @@ static int update_factors(struct ngl_node *node)
         return NGL_ERROR_INVALID_USAGE;
     }
     update_trf_matrix(node, s->factors);
+    ngli_transform_invalidate_static(node);
     return 0;
 }
 
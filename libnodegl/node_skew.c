@@ -73,6 +73,7 @@ static int skew_init(struct ngl_node *node)
     ngli_vec3_norm(s->normed_axis, s->axis);
     if (!s->anim)
         update_trf_matrix(node, s->angles);
+    ngli_transform_set_static(node, !s->anim);
     return 0;
 }
 
@@ -84,6 +85,7 @@ static int update_angles(struct ngl_node *node)
         return NGL_ERROR_INVALID_USAGE;
     }
     update_trf_matrix(node, s->angles);
+    ngli_transform_invalidate_static(node);
     return 0;
 }
 
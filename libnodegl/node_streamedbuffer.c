@@ -115,6 +115,8 @@ static int streamedbuffer_update(struct ngl_node *node, double t)
         if (index < 0) // the requested time `t` is before the first user timestamp
             index = 0;
     }
+    if (index != s->last_index)
+        node->ctx->frame_changed = 1;
     s->last_index = index;
 
     const struct buffer_priv *buffer_priv = s->buffer_node->priv_data;
@@ -189,6 +191,9 @@ static int streamedbuffer_init(struct ngl_node *node)
         return NGL_ERROR_INVALID_ARG;
     }
 
+    ngli_node_buffer_pin_host_data(s->timestamps);
+    ngli_node_buffer_pin_host_data(s->buffer_node);
+
     return check_timestamps_buffer(node);
 }
 
@@ -30,6 +30,7 @@
 #include "log.h"
 #include "math_utils.h"
 #include "pgcache.h"
+#include "sharegroup.h"
 #include "pgcraft.h"
 #include "pipeline.h"
 #include "type.h"
@@ -367,9 +368,9 @@ static int update_character_geometries(struct ngl_node *node)
         }
     }
 
-    if ((ret = ngli_buffer_upload(s->vertices, vertices, nb_vertices * sizeof(*vertices))) < 0 ||
-        (ret = ngli_buffer_upload(s->uvcoords, uvcoords, nb_uvcoords * sizeof(*uvcoords))) < 0 ||
-        (ret = ngli_buffer_upload(s->indices, indices, nb_indices * sizeof(*indices))) < 0)
+    if ((ret = ngli_buffer_upload(s->vertices, vertices, nb_vertices * sizeof(*vertices), 0)) < 0 ||
+        (ret = ngli_buffer_upload(s->uvcoords, uvcoords, nb_uvcoords * sizeof(*uvcoords), 0)) < 0 ||
+        (ret = ngli_buffer_upload(s->indices, indices, nb_indices * sizeof(*indices), 0)) < 0)
         goto end;
 
     s->nb_indices = nb_indices;
@@ -405,8 +406,8 @@ static int init_bounding_box_geometry(struct ngl_node *node)
         (ret = ngli_buffer_init(s->bg_indices,  sizeof(indices),  INDEX_USAGE_FLAGS)) < 0)
         return ret;
 
-    if ((ret = ngli_buffer_upload(s->bg_vertices, vertices, sizeof(vertices))) < 0 ||
-        (ret = ngli_buffer_upload(s->bg_indices,  indices,  sizeof(indices))) < 0)
+    if ((ret = ngli_buffer_upload(s->bg_vertices, vertices, sizeof(vertices), 0)) < 0 ||
+        (ret = ngli_buffer_upload(s->bg_indices,  indices,  sizeof(indices), 0)) < 0)
         return ret;
 
     s->nb_bg_indices = NGLI_ARRAY_NB(indices);
@@ -418,12 +419,16 @@ static int atlas_create(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
     struct gctx *gctx = ctx->gctx;
+    struct sharegroup *sharegroup = ctx->sharegroup;
 
-    if (ctx->font_atlas)
-        return 0;
+    ngli_sharegroup_lock(sharegroup);
 
     struct canvas canvas = {0};
-    int ret = ngli_drawutils_get_font_atlas(&canvas);
+    int ret = 0;
+    if (sharegroup->font_atlas)
+        goto end;
+
+    ret = ngli_drawutils_get_font_atlas(&canvas);
     if (ret < 0)
         goto end;
 
@@ -440,21 +445,28 @@ static int atlas_create(struct ngl_node *node)
                        | NGLI_TEXTURE_USAGE_SAMPLED_BIT,
     };
 
-    ctx->font_atlas = ngli_texture_create(gctx); // freed at context reconfiguration/destruction
-    if (!ctx->font_atlas) {
+    struct texture *font_atlas = ngli_texture_create(gctx);
+    if (!font_atlas) {
         ret = NGL_ERROR_MEMORY;
         goto end;
     }
 
-    ret = ngli_texture_init(ctx->font_atlas, &tex_params);
-    if (ret < 0)
+    if ((ret = ngli_texture_init(font_atlas, &tex_params)) < 0 ||
+        (ret = ngli_texture_upload(font_atlas, canvas.buf, 0)) < 0 ||
+        (ret = ngli_texture_generate_mipmap(font_atlas)) < 0) {
+        ngli_texture_freep(&font_atlas);
         goto end;
+    }
+    if (ctx->config.share_ctx)
+        ngli_texture_uncharge(font_atlas);
 
-    ret = ngli_texture_upload(ctx->font_atlas, canvas.buf, 0);
-    if (ret < 0)
-        goto end;
+    /* make sure the atlas is complete before other contexts of the share group use it */
+    ngli_gctx_wait_idle(gctx);
+
+    sharegroup->font_atlas = font_atlas; // freed with the share group
 
 end:
+    ngli_sharegroup_unlock(sharegroup);
     ngli_free(canvas.buf);
     return ret;
 }
@@ -576,7 +588,7 @@ static int fg_prepare(struct ngl_node *node, struct pipeline_subdesc *desc)
             .name     = "tex",
             .type     = NGLI_PGCRAFT_SHADER_TEX_TYPE_TEXTURE2D,
             .stage    = NGLI_PROGRAM_SHADER_FRAG,
-            .texture  = ctx->font_atlas,
+            .texture  = ctx->sharegroup->font_atlas,
         },
     };
 
@@ -678,6 +690,9 @@ static void text_draw(struct ngl_node *node)
     struct ngl_ctx *ctx = node->ctx;
     struct text_priv *s = node->priv_data;
 
+    if (ctx->hoist_passes)
+        return;
+
     const float *modelview_matrix  = ngli_darray_tail(&ctx->modelview_matrix_stack);
     const float *projection_matrix = ngli_darray_tail(&ctx->projection_matrix_stack);
 
@@ -28,8 +28,10 @@
 #include "gctx.h"
 #include "hwupload.h"
 #include "image.h"
+#include "ktx2.h"
 #include "log.h"
 #include "math_utils.h"
+#include "memory.h"
 #include "nodegl.h"
 #include "nodes.h"
 #include "texture.h"
@@ -157,6 +159,7 @@ static const struct param_choices format_choices = {
 
 
 #define DATA_SRC_TYPES_LIST_2D (const int[]){NGL_NODE_MEDIA,                   \
+                                             NGL_NODE_KTX2IMAGE,               \
                                              BUFFER_NODES                      \
                                              -1}
 
@@ -240,6 +243,129 @@ static const struct node_param texturecube_params[] = {
     {NULL}
 };
 
+static uint64_t get_compressed_format_feature(int format)
+{
+    switch (format) {
+    case NGLI_FORMAT_BC1_RGBA_UNORM_BLOCK:
+    case NGLI_FORMAT_BC3_UNORM_BLOCK:
+        return NGLI_FEATURE_TEXTURE_COMPRESSION_S3TC;
+    case NGLI_FORMAT_BC1_RGBA_SRGB_BLOCK:
+    case NGLI_FORMAT_BC3_SRGB_BLOCK:
+        return NGLI_FEATURE_TEXTURE_COMPRESSION_S3TC_SRGB;
+    case NGLI_FORMAT_BC7_UNORM_BLOCK:
+    case NGLI_FORMAT_BC7_SRGB_BLOCK:
+        return NGLI_FEATURE_TEXTURE_COMPRESSION_BPTC;
+    case NGLI_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+    case NGLI_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+    case NGLI_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+    case NGLI_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+        return NGLI_FEATURE_TEXTURE_COMPRESSION_ETC2;
+    case NGLI_FORMAT_ASTC_4x4_UNORM_BLOCK:
+    case NGLI_FORMAT_ASTC_4x4_SRGB_BLOCK:
+        return NGLI_FEATURE_TEXTURE_COMPRESSION_ASTC;
+    default:
+        ngli_assert(0);
+    }
+}
+
+/*
+ * Compressed levels are uploaded as is when the context supports the format,
+ * which requires immutable storage. Otherwise, the base level is transcoded
+ * on the CPU (when possible) and the mipmaps are regenerated by the GPU.
+ */
+static int upload_ktx2_image(struct ngl_node *node, const struct ktx2 *ktx2)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct gctx *gctx = ctx->gctx;
+    struct texture_priv *s = node->priv_data;
+
+    /* The file dictates the storage, which must not leak into the user parameters */
+    struct texture_params ktx2_params = s->params;
+    struct texture_params *params = &ktx2_params;
+
+    params->width = ktx2->width;
+    params->height = ktx2->height;
+
+    const int compressed = ngli_format_is_compressed(ktx2->format);
+    const uint64_t feature = compressed ? get_compressed_format_feature(ktx2->format) : 0;
+    if (compressed && (gctx->features & feature) && params->immutable) {
+        params->format = ktx2->format;
+        params->nb_levels = params->mipmap_filter != NGLI_MIPMAP_FILTER_NONE ? ktx2->nb_levels : 1;
+        params->usage &= ~NGLI_TEXTURE_USAGE_TRANSFER_SRC_BIT;
+        if (params->nb_levels == 1 && params->mipmap_filter != NGLI_MIPMAP_FILTER_NONE) {
+            LOG(WARNING, "%s does not contain any mipmap level, mipmapping will be disabled",
+                s->data_src->label);
+            params->mipmap_filter = NGLI_MIPMAP_FILTER_NONE;
+        }
+
+        int ret = ngli_texture_init(s->texture, params);
+        if (ret < 0)
+            return ret;
+
+        for (int i = 0; i < params->nb_levels; i++) {
+            const struct ktx2_level *level = &ktx2->levels[i];
+            ret = ngli_texture_upload_compressed(s->texture, i, level->data, level->size);
+            if (ret < 0)
+                return ret;
+        }
+        return 0;
+    }
+
+    if (!compressed) {
+        params->format = ktx2->format;
+        int ret = ngli_texture_init(s->texture, params);
+        if (ret < 0)
+            return ret;
+        return ngli_texture_upload(s->texture, ktx2->levels[0].data, 0);
+    }
+
+    params->format = ngli_ktx2_get_transcode_format(ktx2->format);
+    if (params->format == NGLI_FORMAT_UNDEFINED) {
+        LOG(ERROR, "%s: compressed format is not supported by the context "
+            "and can not be transcoded", s->data_src->label);
+        return NGL_ERROR_UNSUPPORTED;
+    }
+    LOG(WARNING, "%s: compressed format is not supported by the context, "
+        "transcoding it on the CPU", s->data_src->label);
+
+    const int64_t size = ngli_format_get_image_size(params->format, params->width, params->height);
+    uint8_t *data = ngli_malloc(size);
+    if (!data)
+        return NGL_ERROR_MEMORY;
+
+    int ret = ngli_ktx2_transcode_level(ktx2, 0, data);
+    if (ret < 0)
+        goto end;
+
+    ret = ngli_texture_init(s->texture, params);
+    if (ret < 0)
+        goto end;
+
+    ret = ngli_texture_upload(s->texture, data, 0);
+
+end:
+    ngli_free(data);
+    return ret;
+}
+
+static int upload_data(struct ngl_node *node, const uint8_t *data)
+{
+    struct texture_priv *s = node->priv_data;
+
+    int ret = ngli_texture_init(s->texture, &s->params);
+    if (ret < 0)
+        return ret;
+
+    ret = ngli_texture_upload(s->texture, data, 0);
+    if (ret < 0)
+        return ret;
+
+    if (s->data_src && s->data_src->class->category == NGLI_NODE_CATEGORY_BUFFER)
+        ngli_node_buffer_release_host_data(s->data_src);
+
+    return 0;
+}
+
 static int texture_prefetch(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -259,11 +385,22 @@ static int texture_prefetch(struct ngl_node *node)
         params->usage |= NGLI_TEXTURE_USAGE_TRANSFER_SRC_BIT;
 
     const uint8_t *data = NULL;
+    struct ngl_node *ktx2_node = NULL;
+    const struct ktx2 *ktx2 = NULL;
 
     if (s->data_src) {
         switch (s->data_src->class->id) {
         case NGL_NODE_MEDIA:
             return 0;
+        case NGL_NODE_KTX2IMAGE: {
+            int ret = ngli_node_ktx2image_load(s->data_src);
+            if (ret < 0)
+                return ret;
+            struct ktx2image_priv *ktx2image = s->data_src->priv_data;
+            ktx2_node = s->data_src;
+            ktx2 = &ktx2image->ktx2;
+            break;
+        }
         case NGL_NODE_ANIMATEDBUFFERFLOAT:
         case NGL_NODE_ANIMATEDBUFFERVEC2:
         case NGL_NODE_ANIMATEDBUFFERVEC4:
@@ -311,6 +448,11 @@ static int texture_prefetch(struct ngl_node *node)
                     params->height = params->depth = 1;
                 }
             }
+
+            int ret = ngli_node_buffer_load_host_data(s->data_src);
+            if (ret < 0)
+                return ret;
+
             data = buffer->data;
             params->format = buffer->data_format;
             break;
@@ -324,18 +466,19 @@ static int texture_prefetch(struct ngl_node *node)
     if (!s->texture)
         return NGL_ERROR_MEMORY;
 
-    int ret = ngli_texture_init(s->texture, params);
-    if (ret < 0)
-        return ret;
-
-    ret = ngli_texture_upload(s->texture, data, 0);
+    ngli_profile_start(&ctx->profile, node, NGLI_PROFILE_PHASE_TEXTURE_UPLOAD);
+    int ret = ktx2 ? upload_ktx2_image(node, ktx2) : upload_data(node, data);
+    ngli_profile_stop(&ctx->profile);
+    if (ktx2_node)
+        ngli_node_ktx2image_release(ktx2_node);
     if (ret < 0)
         return ret;
 
+    const struct texture_params *texture_params = &s->texture->params;
     struct image_params image_params = {
-        .width = params->width,
-        .height = params->height,
-        .depth = params->depth,
+        .width = texture_params->width,
+        .height = texture_params->height,
+        .depth = texture_params->depth,
         .layout = NGLI_IMAGE_LAYOUT_DEFAULT,
     };
     ngli_image_init(&s->image, &image_params, &s->texture);
@@ -36,6 +36,8 @@ static int time_init(struct ngl_node *node)
 static int time_update(struct ngl_node *node, double t)
 {
     struct variable_priv *s = node->priv_data;
+    if (s->scalar != t)
+        node->ctx->frame_changed = 1;
     s->scalar = t;
     return 0;
 }
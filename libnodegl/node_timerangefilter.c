@@ -37,6 +37,7 @@ struct timerangefilter_priv {
     double max_idle_time;
 
     int drawme;
+    int evict;
 };
 
 #define RANGES_TYPES_LIST (const int[]){NGL_NODE_TIMERANGEMODEONCE,     \
@@ -136,6 +137,9 @@ static int timerangefilter_visit(struct ngl_node *node, int is_active, double t)
     struct timerangefilter_priv *s = node->priv_data;
     struct ngl_node *child = s->child;
 
+    const int evict = s->evict;
+    s->evict = 0;
+
     /*
      * The life of the parent takes over the life of its children: if the
      * parent is dead, the children are likely dead as well. However, a living
@@ -165,6 +169,9 @@ static int timerangefilter_visit(struct ngl_node *node, int is_active, double t)
                         // The node will actually be needed soon, so we need to
                         // start it if necessary.
                         is_active = 1;
+                    } else if (next_use_in <= s->max_idle_time && child->is_active && evict) {
+                        TRACE("%s not currently needed, release it to honor the GPU memory budget",
+                              child->label);
                     } else if (next_use_in <= s->max_idle_time && child->is_active) {
                         TRACE("%s not currently needed but will be soon %g (< %g), keep as active",
                               child->label, next_use_in, s->max_idle_time);
@@ -175,6 +182,16 @@ static int timerangefilter_visit(struct ngl_node *node, int is_active, double t)
                         // already active it's not worth releasing it to start
                         // it again soon after, so we keep it active.
                         is_active = 1;
+
+                        // It remains a candidate for release if the GPU
+                        // memory budget is exceeded.
+                        const struct eviction_candidate candidate = {
+                            .node     = child,
+                            .next_use = next_use_in,
+                            .evict    = &s->evict,
+                        };
+                        if (!ngli_darray_push(&node->ctx->eviction_candidates, &candidate))
+                            return NGL_ERROR_MEMORY;
                     }
                 }
             } else if (rr->class->id == NGL_NODE_TIMERANGEMODEONCE) {
@@ -192,7 +209,7 @@ static int timerangefilter_visit(struct ngl_node *node, int is_active, double t)
     return ngli_node_visit(child, is_active, t);
 }
 
-static int timerangefilter_update(struct ngl_node *node, double t)
+static int update_child(struct ngl_node *node, double t)
 {
     struct timerangefilter_priv *s = node->priv_data;
 
@@ -220,6 +237,17 @@ static int timerangefilter_update(struct ngl_node *node, double t)
     return ngli_node_update(child, t);
 }
 
+static int timerangefilter_update(struct ngl_node *node, double t)
+{
+    struct timerangefilter_priv *s = node->priv_data;
+
+    const int drawme = s->drawme;
+    int ret = update_child(node, t);
+    if (s->drawme != drawme)
+        node->ctx->frame_changed = 1;
+    return ret;
+}
+
 static void timerangefilter_draw(struct ngl_node *node)
 {
     struct timerangefilter_priv *s = node->priv_data;
@@ -48,6 +48,7 @@ static int update_vector(struct ngl_node *node)
         return NGL_ERROR_INVALID_USAGE;
     }
     update_trf_matrix(node, s->vector);
+    ngli_transform_invalidate_static(node);
     return 0;
 }
 
@@ -56,6 +57,7 @@ static int translate_init(struct ngl_node *node)
     struct translate_priv *s = node->priv_data;
     if (!s->anim)
         update_trf_matrix(node, s->vector);
+    ngli_transform_set_static(node, !s->anim);
     return 0;
 }
 
@@ -56,6 +56,12 @@ static int triangle_init(struct ngl_node *node)
 {
     struct geometry_priv *s = node->priv_data;
 
+    s->topology = NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    int ret = ngli_node_geometry_cache_ref(node);
+    if (ret != 0)
+        return NGLI_MIN(ret, 0);
+
     s->vertices_buffer = ngli_node_geometry_generate_buffer(node->ctx,
                                                             NGL_NODE_BUFFERVEC3,
                                                             NB_VERTICES,
@@ -89,25 +95,12 @@ static int triangle_init(struct ngl_node *node)
     if (!s->normals_buffer)
         return NGL_ERROR_MEMORY;
 
-    s->topology = NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-
-    return 0;
+    return ngli_node_geometry_cache_add(node);
 }
 
-#define NODE_UNREFP(node) do {                    \
-    if (node) {                                   \
-        ngli_node_detach_ctx(node, node->ctx);    \
-        ngl_node_unrefp(&node);                   \
-    }                                             \
-} while (0)
-
 static void triangle_uninit(struct ngl_node *node)
 {
-    struct geometry_priv *s = node->priv_data;
-
-    NODE_UNREFP(s->vertices_buffer);
-    NODE_UNREFP(s->uvcoords_buffer);
-    NODE_UNREFP(s->normals_buffer);
+    ngli_node_geometry_cache_unref(node);
 }
 
 const struct node_class ngli_triangle_class = {
@@ -19,14 +19,36 @@
  * under the License.
  */
 
+#include <math.h>
 #include <stddef.h>
 
 #include "nodes.h"
 #include "params.h"
 
+enum {
+    RESIDENCY_RELEASE,
+    RESIDENCY_KEEP_WARM,
+    RESIDENCY_EAGER,
+};
+
 struct userswitch {
     struct ngl_node *child;
     int enabled;
+    int residency;
+    int warm_up;
+
+    int evict;   // set when the kept warm child must be released to honor the GPU memory budget
+    int evicted; // the kept warm child has been released and is not kept warm until enabled again
+};
+
+static const struct param_choices residency_choices = {
+    .name = "residency",
+    .consts = {
+        {"release",   RESIDENCY_RELEASE,   .desc=NGLI_DOCSTRING("release the child resources when disabled")},
+        {"keep_warm", RESIDENCY_KEEP_WARM, .desc=NGLI_DOCSTRING("keep the child resources once prefetched, even when disabled (until exceeding the GPU memory budget)")},
+        {"eager",     RESIDENCY_EAGER,     .desc=NGLI_DOCSTRING("prefetch the child resources even if never enabled, and keep them (until exceeding the GPU memory budget)")},
+        {NULL}
+    }
 };
 
 #define OFFSET(x) offsetof(struct userswitch, x)
@@ -37,13 +59,53 @@ static const struct node_param userswitch_params[] = {
     {"enabled", PARAM_TYPE_BOOL, OFFSET(enabled), {.i64=1},
                .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE,
                .desc=NGLI_DOCSTRING("set if the scene should be rendered")},
+    {"residency", PARAM_TYPE_SELECT, OFFSET(residency), {.i64=RESIDENCY_RELEASE},
+                  .choices=&residency_choices,
+                  .desc=NGLI_DOCSTRING("policy for the resources of the child while disabled")},
+    {"warm_up", PARAM_TYPE_BOOL, OFFSET(warm_up),
+                .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE,
+                .desc=NGLI_DOCSTRING("prefetch the child while disabled, so that enabling it later does not stall")},
     {NULL}
 };
 
 static int userswitch_visit(struct ngl_node *node, int is_active, double t)
 {
     struct userswitch *s = node->priv_data;
-    return ngli_node_visit(s->child, is_active && s->enabled, t);
+    struct ngl_node *child = s->child;
+
+    const int evict = s->evict;
+    s->evict = 0;
+    if (s->enabled)
+        s->evicted = 0;
+    else if (evict)
+        s->evicted = 1;
+
+    /*
+     * A disabled child is never updated nor drawn, but it can still be
+     * marked as active so that its resources are prefetched (warm up) or
+     * not released (keep warm), during the frames preceding its enabling.
+     * The residency policies are not honored anymore once the child has been
+     * evicted to honor the GPU memory budget, until it is enabled again.
+     */
+    int child_active = s->enabled || s->warm_up;
+    if (!child_active && !s->evicted) {
+        if (s->residency == RESIDENCY_EAGER ||
+            (s->residency == RESIDENCY_KEEP_WARM && child->is_active)) {
+            child_active = 1;
+
+            if (is_active) {
+                const struct eviction_candidate candidate = {
+                    .node     = child,
+                    .next_use = INFINITY,
+                    .evict    = &s->evict,
+                };
+                if (!ngli_darray_push(&node->ctx->eviction_candidates, &candidate))
+                    return NGL_ERROR_MEMORY;
+            }
+        }
+    }
+
+    return ngli_node_visit(child, is_active && child_active, t);
 }
 
 static int userswitch_update(struct ngl_node *node, double t)
@@ -286,7 +286,9 @@ static int node_init(struct ngl_node *node)
     ngli_assert(node->ctx);
     if (node->class->init) {
         LOG(VERBOSE, "INIT %s @ %p", node->label, node);
+        ngli_profile_start(&node->ctx->profile, node, NGLI_PROFILE_PHASE_INIT);
         int ret = node->class->init(node);
+        ngli_profile_stop(&node->ctx->profile);
         if (ret < 0) {
             LOG(ERROR, "initializing node %s failed: %s", node->label, NGLI_RET_STR(ret));
             node->state = STATE_INIT_FAILED;
@@ -502,7 +504,9 @@ static int node_prefetch(struct ngl_node *node)
 
     if (node->class->prefetch) {
         TRACE("PREFETCH %s @ %p", node->label, node);
+        ngli_profile_start(&node->ctx->profile, node, NGLI_PROFILE_PHASE_PREFETCH);
         int ret = node->class->prefetch(node);
+        ngli_profile_stop(&node->ctx->profile);
         if (ret < 0) {
             LOG(ERROR, "prefetching node %s failed: %s", node->label, NGLI_RET_STR(ret));
             node->visit_time = -1.;
@@ -561,10 +565,37 @@ void ngli_node_draw(struct ngl_node *node)
     if (node->class->draw) {
         TRACE("DRAW %s @ %p", node->label, node);
         node->class->draw(node);
-        node->draw_count++;
+        if (!node->ctx->hoist_passes)
+            node->draw_count++;
     }
 }
 
+/*
+ * Draw the RenderToTexture of the subtree which can run before the current
+ * render pass begins, so the pass does not have to be interrupted (and its
+ * target stored then loaded back) for them. The other draws are skipped: a
+ * RenderToTexture can not be hoisted if its textures are read by a skipped
+ * draw, if its subtree references the targets of the enclosing
+ * RenderToTexture, or once a skipped draw may write data it would read. The
+ * hoisted ones are then skipped by the regular draw of the subtree.
+ */
+void ngli_node_draw_hoisted(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    const int hoist_passes = ctx->hoist_passes;
+    const int hoist_barrier = ctx->hoist_barrier;
+    const int nb_reads = ngli_darray_count(&ctx->hoist_reads);
+
+    ctx->hoist_passes = 1;
+    ctx->hoist_barrier = 0;
+    ngli_node_draw(node);
+
+    while (ngli_darray_count(&ctx->hoist_reads) > nb_reads)
+        ngli_darray_pop(&ctx->hoist_reads);
+    ctx->hoist_passes = hoist_passes;
+    ctx->hoist_barrier = hoist_barrier;
+}
+
 const struct node_param *ngli_node_param_find(const struct ngl_node *node, const char *key,
                                               uint8_t **base_ptrp)
 {
@@ -601,8 +632,11 @@ int ngl_node_param_add(struct ngl_node *node, const char *key,
         return ret;
     }
 
-    if (node->ctx && par->update_func)
-        ret = par->update_func(node);
+    if (node->ctx) {
+        node->ctx->frame_changed = 1;
+        if (par->update_func)
+            ret = par->update_func(node);
+    }
 
     return ret;
 }
@@ -630,8 +664,11 @@ int ngl_node_param_set(struct ngl_node *node, const char *key, ...)
         return ret;
     }
 
-    if (node->ctx && par->update_func)
-        ret = par->update_func(node);
+    if (node->ctx) {
+        node->ctx->frame_changed = 1;
+        if (par->update_func)
+            ret = par->update_func(node);
+    }
 
     return ret;
 }
@@ -48,9 +48,12 @@
 #include "hwconv.h"
 #include "hwupload.h"
 #include "image.h"
+#include "ktx2.h"
 #include "nodegl.h"
 #include "params.h"
 #include "pgcache.h"
+#include "profile.h"
+#include "sharegroup.h"
 #include "program.h"
 #include "darray.h"
 #include "buffer.h"
@@ -63,6 +66,18 @@ struct node_class;
 
 typedef int (*cmd_func_type)(struct ngl_ctx *s, void *arg);
 
+/*
+ * Branch kept active by a TimeRangeFilter or a UserSwitch while not currently
+ * needed, which can be evicted by setting *evict when exceeding the GPU memory
+ * budget. The next use of a disabled UserSwitch branch is unknown and set to
+ * INFINITY, so these branches are evicted first.
+ */
+struct eviction_candidate {
+    struct ngl_node *node;
+    double next_use;
+    int *evict;
+};
+
 struct ngl_ctx {
     /* Controller-only fields */
     int configured;
@@ -80,8 +95,21 @@ struct ngl_ctx {
     struct darray modelview_matrix_stack;
     struct darray projection_matrix_stack;
     struct darray activitycheck_nodes;
-    struct texture *font_atlas;
-    struct pgcache pgcache;
+    struct darray eviction_candidates; // struct eviction_candidate
+    struct profile profile;
+    int64_t static_transforms_rev; // incremented at each live change of a static transform
+    struct hmap *geometry_cache;   // generated primitive geometries shared by identical nodes
+    struct hmap *interleaved_buffers; // interleaved in-memory attributes shared by the passes
+    struct hmap *hwconv_pipelines; // hardware frame conversion pipelines shared by the textures
+    int hwconv_batch;              // hardware frame conversions have been done since the last update
+    int hwconv_prev_viewport[4];   // viewport to restore at the end of the conversions
+    int frame_changed;             // the next frame may differ from the last one drawn
+    int hoist_passes;              // only draw the RenderToTexture able to run ahead of the current pass
+    int hoist_barrier;             // a skipped draw may produce data read by the following passes
+    struct darray hoist_reads;     // texture nodes read by the draws skipped while hoisting
+    struct ngl_node *hoist_rtt;    // RenderToTexture the draws are hoisted ahead of, if any
+    void *last_capture_buffer;     // capture buffer holding the last frame drawn
+    struct sharegroup *sharegroup;
 #if defined(HAVE_VAAPI)
     struct vaapi_ctx vaapi_ctx;
 #endif
@@ -89,6 +117,7 @@ struct ngl_ctx {
     struct android_ctx android_ctx;
 #endif
     struct hud *hud;
+    int64_t block_upload_size; // bytes of block data uploaded during the frame
     int64_t cpu_update_time;
     int64_t cpu_draw_time;
     int64_t gpu_draw_time;
@@ -100,6 +129,10 @@ struct ngl_ctx {
     cmd_func_type cmd_func;
     void *cmd_arg;
     int cmd_ret;
+    int cmd_async;          // whether the pending command has been dispatched asynchronously
+    int async_pending;      // whether the queued frame has not been waited with ngl_wait() yet
+    int async_ret;          // return code of the queued frame, returned by ngl_wait()
+    double async_draw_time;
 };
 
 struct ngl_node {
@@ -158,12 +191,37 @@ struct geometry_priv {
     struct ngl_node *indices_buffer;
 
     int topology;
+    int optimize;
 
     int64_t max_indices;
+
+    struct ngl_node *packed_indices_buffer; // narrowed or strip indices used for drawing instead of indices_buffer
+    int packed_topology;
+    int primitive_restart; // packed indices are strips separated by primitive restart indices
+
+    char *cache_key; // key of the generated buffers in the context geometry cache
 };
 
+#define NGLI_GEOMETRY_OPTIMIZE_VERTEX_CACHE (1 << 0)
+#define NGLI_GEOMETRY_OPTIMIZE_OVERDRAW     (1 << 1)
+#define NGLI_GEOMETRY_OPTIMIZE_VERTEX_FETCH (1 << 2)
+#define NGLI_GEOMETRY_OPTIMIZE_STRIP        (1 << 3)
+
 struct ngl_node *ngli_node_geometry_generate_buffer(struct ngl_ctx *ctx, int type, int count, int size, void *data);
 
+/*
+ * The buffers generated by the Circle, Quad and Triangle nodes are cached per
+ * context and keyed by the node parameters so identical primitives share them.
+ * ngli_node_geometry_cache_ref() returns 1 and sets the geometry buffers if an
+ * identical primitive is already cached; otherwise it returns 0 and the
+ * buffers generated by the caller are registered with
+ * ngli_node_geometry_cache_add(). The buffers of the node, cached or not, are
+ * released by ngli_node_geometry_cache_unref().
+ */
+int ngli_node_geometry_cache_ref(struct ngl_node *node);
+int ngli_node_geometry_cache_add(struct ngl_node *node);
+void ngli_node_geometry_cache_unref(struct ngl_node *node);
+
 struct buffer_priv {
     int count;              // number of elements
     uint8_t *data;          // buffer of <count> elements
@@ -187,7 +245,7 @@ struct buffer_priv {
     int timebase[2];
     struct ngl_node *time_anim;
 
-    FILE *fp;
+    int host_data_pinned;   // host data is accessed by the CPU and must be kept
     int dynamic;
     int data_type;          // any of NGLI_TYPE_*
     int last_index;
@@ -195,12 +253,17 @@ struct buffer_priv {
     struct buffer *buffer;
     int buffer_refcount;
     double buffer_last_upload_time;
+    char *share_key;        // share group key of immutable file-backed buffers (with a share context)
+    int share_usage;        // usage of the buffer referenced in the share group
 };
 
 int ngli_node_buffer_ref(struct ngl_node *node);
 int ngli_node_buffer_init(struct ngl_node *node);
 void ngli_node_buffer_unref(struct ngl_node *node);
 int ngli_node_buffer_upload(struct ngl_node *node);
+int ngli_node_buffer_load_host_data(struct ngl_node *node);
+void ngli_node_buffer_release_host_data(struct ngl_node *node);
+void ngli_node_buffer_pin_host_data(struct ngl_node *node);
 
 struct variable_priv {
     union {
@@ -231,7 +294,6 @@ struct variable_priv {
     int data_size;
     int data_type;          // any of NGLI_TYPE_*
     struct ngl_node *transform;
-    const float *transform_matrix;
     int as_mat4; /* quaternion only */
     int dynamic;
     int live_changed;
@@ -252,6 +314,7 @@ struct block_priv {
     struct buffer *buffer;
     int buffer_refcount;
     int has_changed;
+    uint8_t *dirty_fields;  // per field flag set when its data changed since the last upload
     double buffer_last_upload_time;
 };
 
@@ -287,6 +350,15 @@ struct texture_priv {
     struct hwupload hwupload;
 };
 
+struct ktx2image_priv {
+    const char *filename;
+
+    struct ktx2 ktx2; // released once uploaded by the textures
+};
+
+int ngli_node_ktx2image_load(struct ngl_node *node);
+void ngli_node_ktx2image_release(struct ngl_node *node);
+
 struct media_priv {
     const char *filename;
     int sxplayer_min_level;
@@ -319,6 +391,12 @@ struct timerangemode_priv {
 struct transform_priv {
     struct ngl_node *child;
     NGLI_ALIGNED_MAT(matrix);
+    int is_static;                      // matrix is not animated
+
+    /* chain of static transforms starting at this node, folded into one matrix */
+    NGLI_ALIGNED_MAT(folded_matrix);
+    struct ngl_node *folded_child;      // first node following the static chain
+    int64_t folded_rev;                 // ngl_ctx.static_transforms_rev at folding time
 };
 
 struct identity_priv {
@@ -473,6 +551,7 @@ int ngli_node_honor_release_prefetch(struct darray *nodes_array);
 int ngli_node_update(struct ngl_node *node, double t);
 int ngli_prepare_draw(struct ngl_ctx *s, double t);
 void ngli_node_draw(struct ngl_node *node);
+void ngli_node_draw_hoisted(struct ngl_node *node);
 
 int ngli_node_attach_ctx(struct ngl_node *node, struct ngl_ctx *ctx);
 void ngli_node_detach_ctx(struct ngl_node *node, struct ngl_ctx *ctx);
@@ -93,6 +93,7 @@
     action(NGL_NODE_IOMAT3,                 ngli_iomat3_class)                  \
     action(NGL_NODE_IOMAT4,                 ngli_iomat4_class)                  \
     action(NGL_NODE_IOBOOL,                 ngli_iobool_class)                  \
+    action(NGL_NODE_KTX2IMAGE,              ngli_ktx2image_class)               \
     action(NGL_NODE_MEDIA,                  ngli_media_class)                   \
     action(NGL_NODE_PROGRAM,                ngli_program_class)                 \
     action(NGL_NODE_QUAD,                   ngli_quad_class)                    \
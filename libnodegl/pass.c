@@ -19,6 +19,7 @@
  * under the License.
  */
 
+#include <math.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
@@ -26,6 +27,7 @@
 #include <inttypes.h>
 
 #include "block.h"
+#include "bstr.h"
 #include "buffer.h"
 #include "gctx.h"
 #include "hmap.h"
@@ -33,12 +35,15 @@
 #include "log.h"
 #include "math_utils.h"
 #include "memory.h"
+#include "meshopt.h"
 #include "nodegl.h"
 #include "nodes.h"
 #include "pass.h"
 #include "pgcraft.h"
 #include "pipeline.h"
+#include "precision.h"
 #include "program.h"
+#include "sharegroup.h"
 #include "texture.h"
 #include "topology.h"
 #include "type.h"
@@ -50,8 +55,94 @@ struct pipeline_desc {
     int modelview_matrix_index;
     int projection_matrix_index;
     int normal_matrix_index;
+    struct darray stream_bindings; // struct stream_binding, one per instance stream
 };
 
+/*
+ * Number of GPU buffers cycled by an instance stream: the CPU writes the
+ * instances of a frame into a buffer the GPU is no longer reading from, so
+ * the update never waits for the previous draws to complete.
+ */
+#define NB_STREAM_BUFFERS 3
+
+struct instance_stream {
+    const char *name;
+    struct ngl_node *node;
+    struct buffer *buffers[NB_STREAM_BUFFERS];
+    int current;
+    double last_upload_time;
+};
+
+struct stream_binding {
+    int index;             // first pipeline attribute index, -1 if unused by the program
+    int count;             // number of pipeline attributes (4 for a mat4)
+    struct buffer *buffer; // buffer currently bound to the pipeline
+};
+
+/*
+ * The precisions derived from the values are limited to the variables whose
+ * values are known ahead: the static buffers of floats and the animations
+ * whose easings do not overshoot the keyframe values. The uniforms can be
+ * live changed to any value and are thus kept to the default precision.
+ */
+static int get_buffer_precision(const struct pass *s, const struct buffer_priv *buffer_priv)
+{
+    const struct ngl_ctx *ctx = s->ctx;
+    if (!ctx->config.derive_precision || buffer_priv->dynamic || buffer_priv->block || !buffer_priv->data)
+        return NGLI_PRECISION_AUTO;
+
+    switch (buffer_priv->data_format) {
+    case NGLI_FORMAT_R32_SFLOAT:
+    case NGLI_FORMAT_R32G32_SFLOAT:
+    case NGLI_FORMAT_R32G32B32_SFLOAT:
+    case NGLI_FORMAT_R32G32B32A32_SFLOAT:
+        return ngli_precision_get_lowest(NGLI_TYPE_FLOAT, buffer_priv->data,
+                                         buffer_priv->data_size / sizeof(float));
+    default:
+        return NGLI_PRECISION_AUTO;
+    }
+}
+
+static int get_animation_precision(const struct ngl_node *node)
+{
+    const struct variable_priv *variable_priv = node->priv_data;
+
+    int nb_comp;
+    switch (node->class->id) {
+    case NGL_NODE_ANIMATEDFLOAT: nb_comp = 1; break;
+    case NGL_NODE_ANIMATEDVEC2:  nb_comp = 2; break;
+    case NGL_NODE_ANIMATEDVEC3:  nb_comp = 3; break;
+    case NGL_NODE_ANIMATEDVEC4:  nb_comp = 4; break;
+    default:
+        return NGLI_PRECISION_AUTO;
+    }
+
+    float min = INFINITY, max = -INFINITY;
+    for (int i = 0; i < variable_priv->nb_animkf; i++) {
+        const struct animkeyframe_priv *kf = variable_priv->animkf[i]->priv_data;
+        if (kf->easing > EASING_CIRCULAR_OUT_IN)
+            return NGLI_PRECISION_AUTO;
+        for (int j = 0; j < kf->nb_args; j++)
+            if (kf->args[j] <= 0.)
+                return NGLI_PRECISION_AUTO;
+        for (int c = 0; c < nb_comp; c++) {
+            const float v = nb_comp == 1 ? kf->scalar : kf->value[c];
+            min = NGLI_MIN(min, v);
+            max = NGLI_MAX(max, v);
+        }
+    }
+    return ngli_precision_get_lowest_in_range(min, max);
+}
+
+static int get_variable_precision(const struct pass *s, const struct ngl_node *node)
+{
+    const struct ngl_ctx *ctx = s->ctx;
+    const struct variable_priv *variable_priv = node->priv_data;
+    if (!ctx->config.derive_precision || !variable_priv->dynamic)
+        return NGLI_PRECISION_AUTO;
+    return get_animation_precision(node);
+}
+
 static int register_uniform(struct pass *s, const char *name, struct ngl_node *uniform, int stage)
 {
     if (!ngli_darray_push(&s->uniform_nodes, &uniform))
@@ -62,13 +153,15 @@ static int register_uniform(struct pass *s, const char *name, struct ngl_node *u
 
     if (uniform->class->category == NGLI_NODE_CATEGORY_BUFFER) {
         struct buffer_priv *buffer_priv = uniform->priv_data;
-        crafter_uniform.type  = buffer_priv->data_type;
-        crafter_uniform.count = buffer_priv->count;
-        crafter_uniform.data  = buffer_priv->data;
+        crafter_uniform.type      = buffer_priv->data_type;
+        crafter_uniform.count     = buffer_priv->count;
+        crafter_uniform.data      = buffer_priv->data;
+        crafter_uniform.precision = get_buffer_precision(s, buffer_priv);
     } else if (uniform->class->category == NGLI_NODE_CATEGORY_UNIFORM) {
         struct variable_priv *variable_priv = uniform->priv_data;
-        crafter_uniform.type  = variable_priv->data_type;
-        crafter_uniform.data  = variable_priv->data;
+        crafter_uniform.type      = variable_priv->data_type;
+        crafter_uniform.data      = variable_priv->data;
+        crafter_uniform.precision = get_variable_precision(s, uniform);
     } else {
         ngli_assert(0);
     }
@@ -78,7 +171,8 @@ static int register_uniform(struct pass *s, const char *name, struct ngl_node *u
         struct ngl_node *resprops_node = ngli_hmap_get(params->properties, name);
         if (resprops_node) {
             const struct resourceprops_priv *resprops = resprops_node->priv_data;
-            crafter_uniform.precision = resprops->precision;
+            if (resprops->precision != NGLI_PRECISION_AUTO)
+                crafter_uniform.precision = resprops->precision;
         }
     }
 
@@ -150,6 +244,7 @@ static int register_texture(struct pass *s, const char *name, struct ngl_node *t
             }
             crafter_texture.writable  = resprops->writable;
             crafter_texture.precision = resprops->precision;
+            s->has_writable_resources |= resprops->writable;
         }
     }
 
@@ -205,6 +300,7 @@ static int register_block(struct pass *s, const char *name, struct ngl_node *blo
             writable = resprops->writable;
         }
     }
+    s->has_writable_resources |= writable;
 
     block_priv->usage |= usage;
 
@@ -264,11 +360,52 @@ static int check_attributes(struct pass *s, struct hmap *attributes, int per_ins
     return 0;
 }
 
+static int push_crafter_attribute(struct pass *s, const char *name, const struct buffer_priv *attribute_priv,
+                                  int format, struct buffer *buffer, int stride, int offset, int rate)
+{
+    /*
+     * FIXME: we should probably expose ngl_position as vec3 instead of vec4 to
+     * avoid this exception.
+     */
+    const int attr_type = strcmp(name, "ngl_position") ? attribute_priv->data_type : NGLI_TYPE_VEC4;
+
+    struct pgcraft_attribute crafter_attribute = {
+        .type      = attr_type,
+        .format    = format,
+        .stride    = stride,
+        .offset    = offset,
+        .rate      = rate,
+        .buffer    = buffer,
+        .precision = get_buffer_precision(s, attribute_priv),
+    };
+    snprintf(crafter_attribute.name, sizeof(crafter_attribute.name), "%s", name);
+
+    const struct pass_params *params = &s->params;
+    if (params->properties) {
+        const struct ngl_node *resprops_node = ngli_hmap_get(params->properties, name);
+        if (resprops_node) {
+            const struct resourceprops_priv *resprops = resprops_node->priv_data;
+            if (resprops->precision != NGLI_PRECISION_AUTO)
+                crafter_attribute.precision = resprops->precision;
+        }
+    }
+
+    if (!ngli_darray_push(&s->crafter_attributes, &crafter_attribute))
+        return NGL_ERROR_MEMORY;
+
+    return 0;
+}
+
 static int register_attribute(struct pass *s, const char *name, struct ngl_node *attribute, int rate)
 {
     if (!attribute)
         return 0;
 
+    /* the usage must be known when referencing a buffer of the share group */
+    struct buffer_priv *attribute_priv = attribute->priv_data;
+    if (!attribute_priv->block)
+        attribute_priv->usage |= NGLI_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+
     int ret = ngli_node_buffer_ref(attribute);
     if (ret < 0)
         return ret;
@@ -278,8 +415,6 @@ static int register_attribute(struct pass *s, const char *name, struct ngl_node
         return NGL_ERROR_MEMORY;
     }
 
-    struct buffer_priv *attribute_priv = attribute->priv_data;
-    const int format = attribute_priv->data_format;
     int stride;
     int offset;
     struct buffer *buffer;
@@ -297,40 +432,526 @@ static int register_attribute(struct pass *s, const char *name, struct ngl_node
         stride = attribute_priv->data_stride;
         offset = 0;
         buffer = attribute_priv->buffer;
-        attribute_priv->usage |= NGLI_BUFFER_USAGE_VERTEX_BUFFER_BIT;
     }
 
-    /*
-     * FIXME: we should probably expose ngl_position as vec3 instead of vec4 to
-     * avoid this exception.
-     */
-    const int attr_type = strcmp(name, "ngl_position") ? attribute_priv->data_type : NGLI_TYPE_VEC4;
+    return push_crafter_attribute(s, name, attribute_priv, attribute_priv->data_format,
+                                  buffer, stride, offset, rate);
+}
 
-    struct pgcraft_attribute crafter_attribute = {
-        .type   = attr_type,
-        .format = format,
-        .stride = stride,
-        .offset = offset,
-        .rate   = rate,
-        .buffer = buffer,
-    };
-    snprintf(crafter_attribute.name, sizeof(crafter_attribute.name), "%s", name);
+struct vertex_attribute {
+    const char *name;
+    struct ngl_node *node;
+    int quantize; // NGLI_QUANTIZE_* applicable if the attribute is static
+    int format;   // storage format in the interleaved buffer
+};
+
+enum {
+    NGLI_QUANTIZE_NONE,
+    NGLI_QUANTIZE_POSITION,
+    NGLI_QUANTIZE_NORMAL,
+    NGLI_QUANTIZE_UVCOORD,
+};
+
+/*
+ * Maximum quantization errors: the positions are allowed to lose the
+ * precision of a half float relative to the largest extent of their bounding
+ * box (so a mesh far from the origin is kept as float) while the normals and
+ * texture coordinates must be within the normalized range, which bounds their
+ * error to half a quantization step.
+ */
+#define POSITION_MAX_RELATIVE_ERROR (1.f / 1024.f)
+#define NORMAL_MAX_ERROR            (.5f / 127.f)
+#define UVCOORD_MAX_ERROR           (.5f / 65535.f)
+
+static int can_interleave(const struct ngl_node *attribute, int nb_vertices)
+{
+    const struct buffer_priv *attribute_priv = attribute->priv_data;
+    return !attribute_priv->block && !attribute_priv->dynamic && attribute_priv->count == nb_vertices;
+}
+
+static int get_quantized_format(int quantize, int data_format)
+{
+    switch (quantize) {
+    case NGLI_QUANTIZE_POSITION:
+        return data_format == NGLI_FORMAT_R32G32B32_SFLOAT ? NGLI_FORMAT_R16G16B16A16_SFLOAT : -1;
+    case NGLI_QUANTIZE_NORMAL:
+        return data_format == NGLI_FORMAT_R32G32B32_SFLOAT ? NGLI_FORMAT_R8G8B8A8_SNORM : -1;
+    case NGLI_QUANTIZE_UVCOORD:
+        return data_format == NGLI_FORMAT_R32G32_SFLOAT ? NGLI_FORMAT_R16G16_UNORM : -1;
+    }
+    return -1;
+}
+
+static float quantize_attribute(int quantize, uint8_t *dst, int dst_stride,
+                                const float *src, int nb_comp, int count)
+{
+    switch (quantize) {
+    case NGLI_QUANTIZE_POSITION: return ngli_meshopt_quantize_half(dst, dst_stride, src, nb_comp, count);
+    case NGLI_QUANTIZE_NORMAL:   return ngli_meshopt_quantize_snorm8(dst, dst_stride, src, nb_comp, count);
+    case NGLI_QUANTIZE_UVCOORD:  return ngli_meshopt_quantize_unorm16(dst, dst_stride, src, nb_comp, count);
+    }
+    ngli_assert(0);
+    return INFINITY;
+}
+
+static float get_max_error(int quantize, const float *data, int nb_comp, int count)
+{
+    switch (quantize) {
+    case NGLI_QUANTIZE_POSITION: {
+        float max_extent = 0.f;
+        for (int c = 0; c < nb_comp; c++) {
+            float min_value = INFINITY, max_value = -INFINITY;
+            for (int i = 0; i < count; i++) {
+                min_value = NGLI_MIN(min_value, data[i * nb_comp + c]);
+                max_value = NGLI_MAX(max_value, data[i * nb_comp + c]);
+            }
+            max_extent = NGLI_MAX(max_extent, max_value - min_value);
+        }
+        return max_extent * POSITION_MAX_RELATIVE_ERROR;
+    }
+    case NGLI_QUANTIZE_NORMAL:   return NORMAL_MAX_ERROR;
+    case NGLI_QUANTIZE_UVCOORD:  return UVCOORD_MAX_ERROR;
+    }
+    ngli_assert(0);
+    return 0.f;
+}
+
+/*
+ * Select the storage format of an interleaved attribute: if the attribute
+ * quantization is enabled and its error is within bounds, the smaller
+ * quantized format is used, otherwise the attribute is stored as is.
+ */
+static int select_attribute_format(struct pass *s, struct vertex_attribute *attribute)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    struct buffer_priv *attribute_priv = attribute->node->priv_data;
+    attribute->format = attribute_priv->data_format;
+
+    const int quantized_format = get_quantized_format(attribute->quantize, attribute_priv->data_format);
+    if (!ctx->config.quantize_attributes || quantized_format < 0)
+        return 0;
+
+    if (quantized_format == NGLI_FORMAT_R16G16B16A16_SFLOAT &&
+        !(ctx->gctx->features & NGLI_FEATURE_VERTEX_ATTRIB_HALF_FLOAT))
+        return 0;
+
+    /* the normals are encoded for the c/127 decoding */
+    if (quantized_format == NGLI_FORMAT_R8G8B8A8_SNORM &&
+        !(ctx->gctx->features & NGLI_FEATURE_SNORM_SYMMETRIC_CONVERSION))
+        return 0;
+
+    int ret = ngli_node_buffer_load_host_data(attribute->node);
+    if (ret < 0)
+        return ret;
+
+    const int nb_comp = ngli_format_get_nb_comp(attribute_priv->data_format);
+    const float *data = (const float *)attribute_priv->data;
+    const float error = quantize_attribute(attribute->quantize, NULL, 0, data, nb_comp, attribute_priv->count);
+    const float max_error = get_max_error(attribute->quantize, data, nb_comp, attribute_priv->count);
+    ngli_node_buffer_release_host_data(attribute->node);
+
+    if (error <= max_error) {
+        attribute->format = quantized_format;
+        LOG(DEBUG, "quantize %s: max error %g", attribute->name, error);
+    } else {
+        LOG(DEBUG, "keep %s as float: max error %g exceeds %g", attribute->name, error, max_error);
+    }
+
+    return 0;
+}
+
+struct interleaved_buffer {
+    struct buffer *buffer;
+    int refcount;
+};
+
+static void free_interleaved_buffer(void *user_arg, void *data)
+{
+    struct interleaved_buffer *interleaved = data;
+    ngli_buffer_freep(&interleaved->buffer);
+    ngli_free(interleaved);
+}
+
+static int ref_interleaved_buffer(struct pass *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+
+    if (s->interleaved_shared)
+        return ngli_sharegroup_ref_buffer(ctx->sharegroup, ctx->gctx, s->interleaved_key, &s->interleaved_buffer);
+
+    if (!ctx->interleaved_buffers) {
+        ctx->interleaved_buffers = ngli_hmap_create();
+        if (!ctx->interleaved_buffers)
+            return NGL_ERROR_MEMORY;
+        ngli_hmap_set_free(ctx->interleaved_buffers, free_interleaved_buffer, NULL);
+    }
+
+    struct interleaved_buffer *interleaved = ngli_hmap_get(ctx->interleaved_buffers, s->interleaved_key);
+    if (!interleaved) {
+        interleaved = ngli_calloc(1, sizeof(*interleaved));
+        if (!interleaved)
+            return NGL_ERROR_MEMORY;
+
+        interleaved->buffer = ngli_buffer_create(ctx->gctx);
+        if (!interleaved->buffer) {
+            ngli_free(interleaved);
+            return NGL_ERROR_MEMORY;
+        }
+
+        int ret = ngli_hmap_set(ctx->interleaved_buffers, s->interleaved_key, interleaved);
+        if (ret < 0) {
+            free_interleaved_buffer(NULL, interleaved);
+            return ret;
+        }
+    }
+
+    interleaved->refcount++;
+    s->interleaved_buffer = interleaved->buffer;
+    return 0;
+}
+
+static void unref_interleaved_buffer(struct pass *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+
+    if (s->interleaved_shared) {
+        ngli_sharegroup_unref_buffer(ctx->sharegroup, ctx->gctx, s->interleaved_key);
+        return;
+    }
+
+    struct interleaved_buffer *interleaved = ngli_hmap_get(ctx->interleaved_buffers, s->interleaved_key);
+    ngli_assert(interleaved && interleaved->refcount);
+    if (--interleaved->refcount == 0) {
+        ngli_hmap_set(ctx->interleaved_buffers, s->interleaved_key, NULL);
+        if (!ngli_hmap_count(ctx->interleaved_buffers))
+            ngli_hmap_freep(&ctx->interleaved_buffers);
+    }
+}
+
+/*
+ * The static per-vertex attributes are packed (and optionally quantized) into
+ * a single interleaved buffer, shared by all the passes interleaving the same
+ * attributes with the same formats. With a share context, when all the
+ * attributes are file-backed, the content is identified by the files and the
+ * buffer is shared through the share group. Otherwise, it is identified by the
+ * attribute nodes and shared through the context.
+ */
+static int register_interleaved_attributes(struct pass *s, struct vertex_attribute *attributes,
+                                           int nb_attributes, int nb_vertices)
+{
+    struct bstr *key = ngli_bstr_create();
+    struct bstr *shared_key = ngli_bstr_create();
+    if (!key || !shared_key) {
+        ngli_bstr_freep(&key);
+        ngli_bstr_freep(&shared_key);
+        return NGL_ERROR_MEMORY;
+    }
 
+    ngli_bstr_print(key, "interleaved");
+    ngli_bstr_print(shared_key, "interleaved");
+    int shareable = !!s->ctx->config.share_ctx;
+    int stride = 0;
+    for (int i = 0; i < nb_attributes; i++) {
+        if (!can_interleave(attributes[i].node, nb_vertices))
+            continue;
+        int ret = select_attribute_format(s, &attributes[i]);
+        if (ret < 0) {
+            ngli_bstr_freep(&key);
+            ngli_bstr_freep(&shared_key);
+            return ret;
+        }
+        const struct buffer_priv *attribute_priv = attributes[i].node->priv_data;
+        const char *filename = attribute_priv->filename;
+        shareable = shareable && filename;
+        ngli_bstr_printf(key, ":%d/%p", attributes[i].format, (void *)attributes[i].node);
+        if (shareable)
+            ngli_bstr_printf(shared_key, ":%d/%d/%d/%zu/%s", attributes[i].format,
+                             attribute_priv->data_format, attribute_priv->count, strlen(filename), filename);
+        stride += ngli_format_get_bytes_per_pixel(attributes[i].format);
+    }
+
+    s->interleaved_shared = shareable;
+    s->interleaved_key = ngli_bstr_strdup(shareable ? shared_key : key);
+    ngli_bstr_freep(&key);
+    ngli_bstr_freep(&shared_key);
+    if (!s->interleaved_key)
+        return NGL_ERROR_MEMORY;
+
+    int ret = ref_interleaved_buffer(s);
+    if (ret < 0) {
+        ngli_freep(&s->interleaved_key);
+        return ret;
+    }
+    s->interleaved_stride = stride;
+
+    int offset = 0;
+    for (int i = 0; i < nb_attributes; i++) {
+        const struct vertex_attribute *attribute = &attributes[i];
+        if (!can_interleave(attribute->node, nb_vertices)) {
+            ret = register_attribute(s, attribute->name, attribute->node, 0);
+            if (ret < 0)
+                return ret;
+            continue;
+        }
+
+        if (!ngli_darray_push(&s->interleaved_attributes, attribute))
+            return NGL_ERROR_MEMORY;
+
+        const struct buffer_priv *attribute_priv = attribute->node->priv_data;
+        ret = push_crafter_attribute(s, attribute->name, attribute_priv, attribute->format,
+                                     s->interleaved_buffer, stride, offset, 0);
+        if (ret < 0)
+            return ret;
+        offset += ngli_format_get_bytes_per_pixel(attribute->format);
+    }
+
+    return 0;
+}
+
+static int register_vertex_attributes(struct pass *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
     const struct pass_params *params = &s->params;
-    if (params->properties) {
-        const struct ngl_node *resprops_node = ngli_hmap_get(params->properties, name);
-        if (resprops_node) {
-            const struct resourceprops_priv *resprops = resprops_node->priv_data;
-            crafter_attribute.precision = resprops->precision;
+    const struct geometry_priv *geometry_priv = params->geometry->priv_data;
+    const struct buffer_priv *vertices = geometry_priv->vertices_buffer->priv_data;
+    const int nb_vertices = vertices->count;
+
+    struct darray attributes;
+    ngli_darray_init(&attributes, sizeof(struct vertex_attribute), 0);
+
+    const struct vertex_attribute builtins[] = {
+        {"ngl_position", geometry_priv->vertices_buffer, NGLI_QUANTIZE_POSITION},
+        {"ngl_uvcoord",  geometry_priv->uvcoords_buffer, NGLI_QUANTIZE_UVCOORD},
+        {"ngl_normal",   geometry_priv->normals_buffer,  NGLI_QUANTIZE_NORMAL},
+    };
+
+    int ret = 0;
+    for (int i = 0; i < NGLI_ARRAY_NB(builtins); i++) {
+        if (builtins[i].node && !ngli_darray_push(&attributes, &builtins[i])) {
+            ret = NGL_ERROR_MEMORY;
+            goto end;
         }
     }
 
-    if (!ngli_darray_push(&s->crafter_attributes, &crafter_attribute))
+    if (params->attributes) {
+        const struct hmap_entry *entry = NULL;
+        while ((entry = ngli_hmap_next(params->attributes, entry))) {
+            const struct vertex_attribute attribute = {entry->key, entry->data};
+            if (!ngli_darray_push(&attributes, &attribute)) {
+                ret = NGL_ERROR_MEMORY;
+                goto end;
+            }
+        }
+    }
+
+    struct vertex_attribute *attributesp = ngli_darray_data(&attributes);
+    const int nb_attributes = ngli_darray_count(&attributes);
+    int nb_interleavable = 0;
+    int nb_quantizable = 0;
+    for (int i = 0; i < nb_attributes; i++) {
+        if (!can_interleave(attributesp[i].node, nb_vertices))
+            continue;
+        const struct buffer_priv *attribute_priv = attributesp[i].node->priv_data;
+        nb_interleavable++;
+        nb_quantizable += get_quantized_format(attributesp[i].quantize, attribute_priv->data_format) >= 0;
+    }
+
+    /* a single attribute only goes through the interleaved buffer to be quantized */
+    if (nb_interleavable > 1 || (ctx->config.quantize_attributes && nb_quantizable)) {
+        ret = register_interleaved_attributes(s, attributesp, nb_attributes, nb_vertices);
+        goto end;
+    }
+
+    for (int i = 0; i < nb_attributes; i++) {
+        ret = register_attribute(s, attributesp[i].name, attributesp[i].node, 0);
+        if (ret < 0)
+            goto end;
+    }
+
+end:
+    ngli_darray_reset(&attributes);
+    return ret;
+}
+
+static int init_interleaved_buffer(struct pass *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    struct gctx *gctx = ctx->gctx;
+    struct sharegroup *sharegroup = s->interleaved_shared ? ctx->sharegroup : NULL;
+
+    if (s->interleaved_uploaded)
+        return 0;
+
+    if (sharegroup)
+        ngli_sharegroup_lock(sharegroup);
+
+    int ret = 0;
+    uint8_t *data = NULL;
+    if (s->interleaved_buffer->size)
+        goto end;
+
+    /* the buffer may have been created by another context of the share group */
+    s->interleaved_buffer->gctx = gctx;
+
+    const struct vertex_attribute *attributes = ngli_darray_data(&s->interleaved_attributes);
+    const int nb_attributes = ngli_darray_count(&s->interleaved_attributes);
+    const struct buffer_priv *first = attributes[0].node->priv_data;
+    const int count = first->count;
+    const int stride = s->interleaved_stride;
+
+    data = ngli_calloc(count, stride);
+    if (!data) {
+        ret = NGL_ERROR_MEMORY;
+        goto end;
+    }
+
+    int offset = 0;
+    for (int i = 0; i < nb_attributes; i++) {
+        const struct vertex_attribute *attribute = &attributes[i];
+        ret = ngli_node_buffer_load_host_data(attribute->node);
+        if (ret < 0)
+            goto end;
+        const struct buffer_priv *attribute_priv = attribute->node->priv_data;
+        if (attribute->format != attribute_priv->data_format) {
+            const int nb_comp = ngli_format_get_nb_comp(attribute_priv->data_format);
+            quantize_attribute(attribute->quantize, data + offset, stride,
+                               (const float *)attribute_priv->data, nb_comp, count);
+        } else {
+            const int attribute_stride = attribute_priv->data_stride;
+            for (int j = 0; j < count; j++)
+                memcpy(data + j * stride + offset, attribute_priv->data + j * attribute_stride, attribute_stride);
+        }
+        ngli_node_buffer_release_host_data(attribute->node);
+        offset += ngli_format_get_bytes_per_pixel(attribute->format);
+    }
+
+    const int usage = NGLI_BUFFER_USAGE_TRANSFER_DST_BIT | NGLI_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+    if ((ret = ngli_buffer_init(s->interleaved_buffer, count * stride, usage)) < 0 ||
+        (ret = ngli_buffer_upload(s->interleaved_buffer, data, count * stride, 0)) < 0)
+        goto end;
+
+    if (sharegroup) {
+        if (ctx->config.share_ctx)
+            ngli_buffer_uncharge(s->interleaved_buffer);
+        /* make sure the upload is complete before other contexts use the buffer */
+        ngli_gctx_wait_idle(gctx);
+    }
+
+end:
+    if (sharegroup)
+        ngli_sharegroup_unlock(sharegroup);
+    ngli_free(data);
+    if (ret >= 0)
+        s->interleaved_uploaded = 1;
+    return ret;
+}
+
+/*
+ * The dynamic per-instance attributes (animated or streamed buffers) are
+ * uploaded every frame into the next buffer of a ring of NB_STREAM_BUFFERS
+ * which is then bound to the pipelines, instead of overwriting a single
+ * buffer possibly still used by the draws of the previous frames.
+ */
+static int register_instance_stream(struct pass *s, const char *name, struct ngl_node *attribute)
+{
+    struct gctx *gctx = s->ctx->gctx;
+
+    struct instance_stream *stream = ngli_darray_push(&s->instance_streams, NULL);
+    if (!stream)
         return NGL_ERROR_MEMORY;
 
+    *stream = (struct instance_stream){
+        .name             = name,
+        .node             = attribute,
+        .last_upload_time = -1.,
+    };
+
+    for (int i = 0; i < NB_STREAM_BUFFERS; i++) {
+        stream->buffers[i] = ngli_buffer_create(gctx);
+        if (!stream->buffers[i])
+            return NGL_ERROR_MEMORY;
+    }
+
+    const struct buffer_priv *attribute_priv = attribute->priv_data;
+    return push_crafter_attribute(s, name, attribute_priv, attribute_priv->data_format,
+                                  stream->buffers[stream->current], attribute_priv->data_stride, 0, 1);
+}
+
+static int init_instance_streams(struct pass *s)
+{
+    struct instance_stream *streams = ngli_darray_data(&s->instance_streams);
+    for (int i = 0; i < ngli_darray_count(&s->instance_streams); i++) {
+        struct instance_stream *stream = &streams[i];
+        const struct buffer_priv *attribute_priv = stream->node->priv_data;
+        const int usage = NGLI_BUFFER_USAGE_DYNAMIC_BIT |
+                          NGLI_BUFFER_USAGE_TRANSFER_DST_BIT |
+                          NGLI_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+        for (int j = 0; j < NB_STREAM_BUFFERS; j++) {
+            if (stream->buffers[j]->size)
+                continue;
+            int ret = ngli_buffer_init(stream->buffers[j], attribute_priv->data_size, usage);
+            if (ret < 0)
+                return ret;
+        }
+    }
     return 0;
 }
 
+static int init_stream_bindings(struct pass *s, struct pipeline_desc *desc)
+{
+    ngli_darray_init(&desc->stream_bindings, sizeof(struct stream_binding), 0);
+
+    const struct instance_stream *streams = ngli_darray_data(&s->instance_streams);
+    for (int i = 0; i < ngli_darray_count(&s->instance_streams); i++) {
+        const struct instance_stream *stream = &streams[i];
+        const struct buffer_priv *attribute_priv = stream->node->priv_data;
+        const struct stream_binding binding = {
+            .index  = ngli_pgcraft_get_attribute_index(desc->crafter, stream->name),
+            .count  = attribute_priv->data_type == NGLI_TYPE_MAT4 ? 4 : 1,
+            .buffer = stream->buffers[stream->current],
+        };
+        if (!ngli_darray_push(&desc->stream_bindings, &binding))
+            return NGL_ERROR_MEMORY;
+    }
+    return 0;
+}
+
+static int update_instance_streams(struct pass *s, double t)
+{
+    struct instance_stream *streams = ngli_darray_data(&s->instance_streams);
+    for (int i = 0; i < ngli_darray_count(&s->instance_streams); i++) {
+        struct instance_stream *stream = &streams[i];
+        struct ngl_node *node = stream->node;
+        int ret = ngli_node_update(node, t);
+        if (ret < 0)
+            return ret;
+        if (stream->last_upload_time == node->last_update_time)
+            continue;
+        const struct buffer_priv *attribute_priv = node->priv_data;
+        stream->current = (stream->current + 1) % NB_STREAM_BUFFERS;
+        ret = ngli_buffer_upload(stream->buffers[stream->current], attribute_priv->data, attribute_priv->data_size, 0);
+        if (ret < 0)
+            return ret;
+        stream->last_upload_time = node->last_update_time;
+    }
+    return 0;
+}
+
+static void bind_instance_streams(struct pass *s, struct pipeline_desc *desc)
+{
+    const struct instance_stream *streams = ngli_darray_data(&s->instance_streams);
+    struct stream_binding *bindings = ngli_darray_data(&desc->stream_bindings);
+    for (int i = 0; i < ngli_darray_count(&desc->stream_bindings); i++) {
+        struct stream_binding *binding = &bindings[i];
+        struct buffer *buffer = streams[i].buffers[streams[i].current];
+        if (binding->index < 0 || binding->buffer == buffer)
+            continue;
+        for (int j = 0; j < binding->count; j++)
+            ngli_pipeline_update_attribute(desc->pipeline, binding->index + j, buffer);
+        binding->buffer = buffer;
+    }
+}
+
 static int register_resource(struct pass *s, const char *name, struct ngl_node *node, int stage)
 {
     switch (node->class->category) {
@@ -366,16 +987,20 @@ static int pass_graphics_init(struct pass *s)
     struct geometry_priv *geometry_priv = params->geometry->priv_data;
     struct pipeline_graphics *graphics = &s->pipeline_graphics;
 
-    graphics->topology = geometry_priv->topology;
+    graphics->topology = geometry_priv->packed_indices_buffer ? geometry_priv->packed_topology
+                                                              : geometry_priv->topology;
+    graphics->primitive_restart = geometry_priv->packed_indices_buffer && geometry_priv->primitive_restart;
 
     if (geometry_priv->indices_buffer) {
-        struct ngl_node *indices = geometry_priv->indices_buffer;
+        struct ngl_node *indices = geometry_priv->packed_indices_buffer ? geometry_priv->packed_indices_buffer
+                                                                        : geometry_priv->indices_buffer;
         struct buffer_priv *indices_priv = indices->priv_data;
         if (indices_priv->block) {
             LOG(ERROR, "geometry indices buffers referencing a block are not supported");
             return NGL_ERROR_UNSUPPORTED;
         }
 
+        indices_priv->usage |= NGLI_BUFFER_USAGE_INDEX_BUFFER_BIT;
         int ret = ngli_node_buffer_ref(indices);
         if (ret < 0)
             return ret;
@@ -384,7 +1009,6 @@ static int pass_graphics_init(struct pass *s)
         s->indices_buffer = indices_priv->buffer;
         s->indices_format = indices_priv->data_format;
         s->nb_indices = indices_priv->count;
-        indices_priv->usage |= NGLI_BUFFER_USAGE_INDEX_BUFFER_BIT;
     } else {
         struct ngl_node *vertices = geometry_priv->vertices_buffer;
         struct buffer_priv *buffer_priv = vertices->priv_data;
@@ -398,28 +1022,26 @@ static int pass_graphics_init(struct pass *s)
         (ret = register_resources(s, params->frag_resources, NGLI_PROGRAM_SHADER_FRAG)) < 0)
         return ret;
 
+    if ((geometry_priv->optimize & NGLI_GEOMETRY_OPTIMIZE_VERTEX_FETCH) &&
+        params->attributes && ngli_hmap_count(params->attributes)) {
+        LOG(ERROR, "per-vertex attributes can not be used with a geometry reordered for vertex fetch");
+        return NGL_ERROR_INVALID_ARG;
+    }
+
     if ((ret = check_attributes(s, params->attributes, 0)) < 0 ||
         (ret = check_attributes(s, params->instance_attributes, 1)) < 0)
         return ret;
 
-    if ((ret = register_attribute(s, "ngl_position", geometry_priv->vertices_buffer, 0)) < 0 ||
-        (ret = register_attribute(s, "ngl_uvcoord",  geometry_priv->uvcoords_buffer, 0)) < 0 ||
-        (ret = register_attribute(s, "ngl_normal",   geometry_priv->normals_buffer, 0)) < 0)
+    if ((ret = register_vertex_attributes(s)) < 0)
         return ret;
 
-    if (params->attributes) {
-        const struct hmap_entry *entry = NULL;
-        while ((entry = ngli_hmap_next(params->attributes, entry))) {
-            int ret = register_attribute(s, entry->key, entry->data, 0);
-            if (ret < 0)
-                return ret;
-        }
-    }
-
     if (params->instance_attributes) {
         const struct hmap_entry *entry = NULL;
         while ((entry = ngli_hmap_next(params->instance_attributes, entry))) {
-            int ret = register_attribute(s, entry->key, entry->data, 1);
+            const struct buffer_priv *attribute_priv = ((const struct ngl_node *)entry->data)->priv_data;
+            int ret = attribute_priv->dynamic && !attribute_priv->block
+                    ? register_instance_stream(s, entry->key, entry->data)
+                    : register_attribute(s, entry->key, entry->data, 1);
             if (ret < 0)
                 return ret;
         }
@@ -465,12 +1087,22 @@ int ngli_pass_prepare(struct pass *s)
             return ret;
     }
 
+    if (s->interleaved_buffer) {
+        int ret = init_interleaved_buffer(s);
+        if (ret < 0)
+            return ret;
+    }
+
     if (s->indices) {
         int ret = ngli_node_buffer_init(s->indices);
         if (ret < 0)
             return ret;
     }
 
+    int ret = init_instance_streams(s);
+    if (ret < 0)
+        return ret;
+
     struct ngl_node **block_nodes = ngli_darray_data(&s->block_nodes);
     for (int i = 0; i < ngli_darray_count(&s->block_nodes); i++) {
         int ret = ngli_node_block_init(block_nodes[i]);
@@ -517,7 +1149,7 @@ int ngli_pass_prepare(struct pass *s)
         return NGL_ERROR_MEMORY;
 
     struct pipeline_resource_params pipeline_resource_params = {0};
-    int ret = ngli_pgcraft_craft(desc->crafter, &pipeline_params, &pipeline_resource_params, &crafter_params);
+    ret = ngli_pgcraft_craft(desc->crafter, &pipeline_params, &pipeline_resource_params, &crafter_params);
     if (ret < 0)
         return ret;
 
@@ -536,7 +1168,8 @@ int ngli_pass_prepare(struct pass *s)
     desc->modelview_matrix_index = ngli_pgcraft_get_uniform_index(desc->crafter, "ngl_modelview_matrix", NGLI_PROGRAM_SHADER_VERT);
     desc->projection_matrix_index = ngli_pgcraft_get_uniform_index(desc->crafter, "ngl_projection_matrix", NGLI_PROGRAM_SHADER_VERT);
     desc->normal_matrix_index = ngli_pgcraft_get_uniform_index(desc->crafter, "ngl_normal_matrix", NGLI_PROGRAM_SHADER_VERT);
-    return 0;
+
+    return init_stream_bindings(s, desc);
 }
 
 int ngli_pass_init(struct pass *s, struct ngl_ctx *ctx, const struct pass_params *params)
@@ -545,6 +1178,8 @@ int ngli_pass_init(struct pass *s, struct ngl_ctx *ctx, const struct pass_params
     s->params = *params;
 
     ngli_darray_init(&s->attribute_nodes, sizeof(struct ngl_node *), 0);
+    ngli_darray_init(&s->interleaved_attributes, sizeof(struct vertex_attribute), 0);
+    ngli_darray_init(&s->instance_streams, sizeof(struct instance_stream), 0);
     ngli_darray_init(&s->texture_nodes, sizeof(struct ngl_node *), 0);
     ngli_darray_init(&s->uniform_nodes, sizeof(struct ngl_node *), 0);
     ngli_darray_init(&s->block_nodes, sizeof(struct ngl_node *), 0);
@@ -604,12 +1239,27 @@ void ngli_pass_uninit(struct pass *s)
         struct pipeline_desc *desc = &descs[i];
         ngli_pipeline_freep(&desc->pipeline);
         ngli_pgcraft_freep(&desc->crafter);
+        ngli_darray_reset(&desc->stream_bindings);
     }
     ngli_darray_reset(&s->pipeline_descs);
 
+    struct instance_stream *streams = ngli_darray_data(&s->instance_streams);
+    for (int i = 0; i < ngli_darray_count(&s->instance_streams); i++) {
+        for (int j = 0; j < NB_STREAM_BUFFERS; j++)
+            ngli_buffer_freep(&streams[i].buffers[j]);
+    }
+    ngli_darray_reset(&s->instance_streams);
+
     if (s->indices)
         ngli_node_buffer_unref(s->indices);
 
+    if (s->interleaved_key) {
+        unref_interleaved_buffer(s);
+        ngli_freep(&s->interleaved_key);
+        s->interleaved_buffer = NULL;
+    }
+    ngli_darray_reset(&s->interleaved_attributes);
+
     ngli_darray_reset(&s->uniform_nodes);
     ngli_darray_reset(&s->texture_nodes);
     reset_block_nodes(&s->block_nodes);
@@ -660,16 +1310,40 @@ int ngli_pass_update(struct pass *s, double t)
     if ((ret = update_common_nodes(&s->uniform_nodes, t)) < 0 ||
         (ret = update_common_nodes(&s->texture_nodes, t)) < 0 ||
         (ret = update_block_nodes(&s->block_nodes, t)) < 0 ||
-        (ret = update_buffer_nodes(&s->attribute_nodes, t)))
+        (ret = update_buffer_nodes(&s->attribute_nodes, t)) < 0 ||
+        (ret = update_instance_streams(s, t)) < 0)
         return ret;
 
     return 0;
 }
 
+static int skip_hoisted_exec(struct pass *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+
+    if (s->pipeline_type == NGLI_PIPELINE_TYPE_COMPUTE || s->has_writable_resources)
+        ctx->hoist_barrier = 1;
+
+    struct ngl_node **texture_nodes = ngli_darray_data(&s->texture_nodes);
+    for (int i = 0; i < ngli_darray_count(&s->texture_nodes); i++) {
+        if (!ngli_darray_push(&ctx->hoist_reads, &texture_nodes[i]))
+            return NGL_ERROR_MEMORY;
+    }
+
+    return 0;
+}
+
 int ngli_pass_exec(struct pass *s)
 {
     struct ngl_ctx *ctx = s->ctx;
     const struct pass_params *params = &s->params;
+
+    if (ctx->hoist_passes) {
+        int ret = skip_hoisted_exec(s);
+        if (ret < 0)
+            ctx->hoist_barrier = 1;
+        return ret;
+    }
     struct pipeline_desc *descs = ngli_darray_data(&s->pipeline_descs);
     struct pipeline_desc *desc = &descs[ctx->rnode_pos->id];
     struct pipeline *pipeline = desc->pipeline;
@@ -729,6 +1403,8 @@ int ngli_pass_exec(struct pass *s)
     }
 
     if (s->pipeline_type == NGLI_PIPELINE_TYPE_GRAPHICS) {
+        bind_instance_streams(s, desc);
+
         if (ctx->begin_render_pass) {
             struct gctx *gctx = ctx->gctx;
             ngli_gctx_begin_render_pass(gctx, ctx->current_rendertarget);
@@ -63,6 +63,7 @@ struct pass {
     struct pass_params params;
 
     struct darray attribute_nodes;
+    struct darray interleaved_attributes;
     struct darray texture_nodes;
     struct darray uniform_nodes;
     struct darray block_nodes;
@@ -73,6 +74,15 @@ struct pass {
     int nb_indices;
     int nb_vertices;
     int nb_instances;
+    int has_writable_resources;
+
+    struct buffer *interleaved_buffer; // static per-vertex attributes packed together
+    int interleaved_stride;
+    int interleaved_uploaded;
+    char *interleaved_key;   // key of the interleaved buffer in the share group or the context
+    int interleaved_shared;  // the interleaved buffer is owned by the share group (file-backed attributes)
+
+    struct darray instance_streams; // dynamic per-instance attributes (struct instance_stream)
 
     int pipeline_type;
     struct pipeline_graphics pipeline_graphics;
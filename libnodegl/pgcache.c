@@ -21,6 +21,7 @@
 
 #include <string.h>
 
+#include "bstr.h"
 #include "memory.h"
 #include "nodes.h"
 #include "pgcache.h"
@@ -28,7 +29,10 @@
 
 static void reset_cached_program(void *user_arg, void *data)
 {
+    struct pgcache *s = user_arg;
     struct program *p = data;
+    /* the program may have been created by another context of the share group */
+    p->gctx = s->gctx;
     ngli_program_freep(&p);
 }
 
@@ -43,19 +47,22 @@ int ngli_pgcache_init(struct pgcache *s, struct gctx *gctx)
     s->gctx = gctx;
     s->graphics_cache = ngli_hmap_create();
     s->compute_cache = ngli_hmap_create();
-    if (!s->graphics_cache || !s->compute_cache)
+    if (!s->graphics_cache || !s->compute_cache) {
+        ngli_hmap_freep(&s->graphics_cache);
+        ngli_hmap_freep(&s->compute_cache);
+        s->gctx = NULL;
         return NGL_ERROR_MEMORY;
+    }
+    pthread_mutex_init(&s->lock, NULL);
     ngli_hmap_set_free(s->graphics_cache, reset_cached_frag_map, s);
     ngli_hmap_set_free(s->compute_cache, reset_cached_program, s);
     return 0;
 }
 
-static int query_cache(struct pgcache *s, struct program **dstp,
+static int query_cache(struct pgcache *s, struct gctx *gctx, struct program **dstp,
                        struct hmap *cache, const char *cache_key,
                        const char *vert, const char *frag, const char *comp)
 {
-    struct gctx *gctx = s->gctx;
-
     struct program *cached_program = ngli_hmap_get(cache, cache_key);
     if (cached_program) {
         /* make sure the cached program has not been reset by the user */
@@ -86,7 +93,7 @@ static int query_cache(struct pgcache *s, struct program **dstp,
     return 0;
 }
 
-int ngli_pgcache_get_graphics_program(struct pgcache *s, struct program **dstp, const char *vert, const char *frag)
+static int get_graphics_program(struct pgcache *s, struct gctx *gctx, struct program **dstp, const char *vert, const char *frag)
 {
     /*
      * The first dimension of the graphics_cache hmap is another hmap: what we
@@ -107,19 +114,65 @@ int ngli_pgcache_get_graphics_program(struct pgcache *s, struct program **dstp,
         }
     }
 
-    return query_cache(s, dstp, frag_map, frag, vert, frag, NULL);
+    return query_cache(s, gctx, dstp, frag_map, frag, vert, frag, NULL);
+}
+
+int ngli_pgcache_get_graphics_program(struct pgcache *s, struct gctx *gctx, struct program **dstp, const char *vert, const char *frag)
+{
+    pthread_mutex_lock(&s->lock);
+    int ret = get_graphics_program(s, gctx, dstp, vert, frag);
+    pthread_mutex_unlock(&s->lock);
+    return ret;
+}
+
+int ngli_pgcache_get_compute_program(struct pgcache *s, struct gctx *gctx, struct program **dstp, const char *comp)
+{
+    pthread_mutex_lock(&s->lock);
+    int ret = query_cache(s, gctx, dstp, s->compute_cache, comp, NULL, NULL, comp);
+    pthread_mutex_unlock(&s->lock);
+    return ret;
+}
+
+static char *dump_cache(struct pgcache *s)
+{
+    struct bstr *b = ngli_bstr_create();
+    if (!b)
+        return NULL;
+
+    const struct hmap_entry *vert_entry = NULL;
+    while ((vert_entry = ngli_hmap_next(s->graphics_cache, vert_entry))) {
+        const struct hmap *frag_map = vert_entry->data;
+        const struct hmap_entry *frag_entry = NULL;
+        while ((frag_entry = ngli_hmap_next(frag_map, frag_entry))) {
+            ngli_bstr_printf(b, "// vertex\n%s\n", vert_entry->key);
+            ngli_bstr_printf(b, "// fragment\n%s\n", frag_entry->key);
+        }
+    }
+
+    const struct hmap_entry *comp_entry = NULL;
+    while ((comp_entry = ngli_hmap_next(s->compute_cache, comp_entry)))
+        ngli_bstr_printf(b, "// compute\n%s\n", comp_entry->key);
+
+    char *ret = ngli_bstr_check(b) < 0 ? NULL : ngli_bstr_strdup(b);
+    ngli_bstr_freep(&b);
+    return ret;
 }
 
-int ngli_pgcache_get_compute_program(struct pgcache *s, struct program **dstp, const char *comp)
+char *ngli_pgcache_dump(struct pgcache *s)
 {
-    return query_cache(s, dstp, s->compute_cache, comp, NULL, NULL, comp);
+    pthread_mutex_lock(&s->lock);
+    char *ret = dump_cache(s);
+    pthread_mutex_unlock(&s->lock);
+    return ret;
 }
 
-void ngli_pgcache_reset(struct pgcache *s)
+void ngli_pgcache_reset(struct pgcache *s, struct gctx *gctx)
 {
     if (!s->gctx)
         return;
+    s->gctx = gctx;
     ngli_hmap_freep(&s->compute_cache);
     ngli_hmap_freep(&s->graphics_cache);
+    pthread_mutex_destroy(&s->lock);
     memset(s, 0, sizeof(*s));
 }
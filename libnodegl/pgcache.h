@@ -22,18 +22,28 @@
 #ifndef PGCACHE_H
 #define PGCACHE_H
 
+#include <pthread.h>
+
 #include "hmap.h"
 #include "program.h"
 
+/*
+ * The program cache may be shared between several contexts of the same share
+ * group (see sharegroup.h): the programs are created with the graphics
+ * context of the caller, and released with the graphics context passed to
+ * ngli_pgcache_reset().
+ */
 struct pgcache {
     struct gctx *gctx;
+    pthread_mutex_t lock;
     struct hmap *graphics_cache;
     struct hmap *compute_cache;
 };
 
 int ngli_pgcache_init(struct pgcache *s, struct gctx *ctx);
-int ngli_pgcache_get_graphics_program(struct pgcache *s, struct program **dstp, const char *vert, const char *frag);
-int ngli_pgcache_get_compute_program(struct pgcache *s, struct program **dstp, const char *comp);
-void ngli_pgcache_reset(struct pgcache *s);
+int ngli_pgcache_get_graphics_program(struct pgcache *s, struct gctx *gctx, struct program **dstp, const char *vert, const char *frag);
+int ngli_pgcache_get_compute_program(struct pgcache *s, struct gctx *gctx, struct program **dstp, const char *comp);
+char *ngli_pgcache_dump(struct pgcache *s);
+void ngli_pgcache_reset(struct pgcache *s, struct gctx *gctx);
 
 #endif
@@ -1170,7 +1170,9 @@ static int get_program_compute(struct pgcraft *s, const struct pgcraft_params *p
         return ret;
 
     const char *comp = ngli_bstr_strptr(s->shaders[NGLI_PROGRAM_SHADER_COMP]);
-    ret = ngli_pgcache_get_compute_program(&s->ctx->pgcache, &s->program, comp);
+    ngli_profile_start(&s->ctx->profile, NULL, NGLI_PROFILE_PHASE_SHADER_COMPILE);
+    ret = ngli_pgcache_get_compute_program(&s->ctx->sharegroup->pgcache, s->ctx->gctx, &s->program, comp);
+    ngli_profile_stop(&s->ctx->profile);
     ngli_bstr_freep(&s->shaders[NGLI_PROGRAM_SHADER_COMP]);
     return ret;
 }
@@ -1195,7 +1197,9 @@ static int get_program_graphics(struct pgcraft *s, const struct pgcraft_params *
 
     const char *vert = ngli_bstr_strptr(s->shaders[NGLI_PROGRAM_SHADER_VERT]);
     const char *frag = ngli_bstr_strptr(s->shaders[NGLI_PROGRAM_SHADER_FRAG]);
-    ret = ngli_pgcache_get_graphics_program(&s->ctx->pgcache, &s->program, vert, frag);
+    ngli_profile_start(&s->ctx->profile, NULL, NGLI_PROFILE_PHASE_SHADER_COMPILE);
+    ret = ngli_pgcache_get_graphics_program(&s->ctx->sharegroup->pgcache, s->ctx->gctx, &s->program, vert, frag);
+    ngli_profile_stop(&s->ctx->profile);
     ngli_bstr_freep(&s->shaders[NGLI_PROGRAM_SHADER_VERT]);
     ngli_bstr_freep(&s->shaders[NGLI_PROGRAM_SHADER_FRAG]);
     return ret;
@@ -1206,8 +1210,10 @@ int ngli_pgcraft_craft(struct pgcraft *s,
                        struct pipeline_resource_params *dst_data_params,
                        const struct pgcraft_params *params)
 {
+    ngli_profile_start(&s->ctx->profile, NULL, NGLI_PROFILE_PHASE_SHADER_GEN);
     int ret = params->comp_base ? get_program_compute(s, params)
                                 : get_program_graphics(s, params);
+    ngli_profile_stop(&s->ctx->profile);
     if (ret < 0)
         return ret;
 
@@ -1242,6 +1248,17 @@ int ngli_pgcraft_get_uniform_index(const struct pgcraft *s, const char *name, in
     return get_uniform_index(s, name);
 }
 
+int ngli_pgcraft_get_attribute_index(const struct pgcraft *s, const char *name)
+{
+    const struct pipeline_attribute_desc *pipeline_attribute_descs = ngli_darray_data(&s->filtered_pipeline_info.desc.attributes);
+    for (int i = 0; i < ngli_darray_count(&s->filtered_pipeline_info.desc.attributes); i++) {
+        const struct pipeline_attribute_desc *pipeline_attribute_desc = &pipeline_attribute_descs[i];
+        if (!strcmp(pipeline_attribute_desc->name, name))
+            return i;
+    }
+    return -1;
+}
+
 void ngli_pgcraft_freep(struct pgcraft **sp)
 {
     struct pgcraft *s = *sp;
@@ -208,6 +208,7 @@ int ngli_pgcraft_craft(struct pgcraft *s,
                        const struct pgcraft_params *params);
 
 int ngli_pgcraft_get_uniform_index(const struct pgcraft *s, const char *name, int stage);
+int ngli_pgcraft_get_attribute_index(const struct pgcraft *s, const char *name);
 
 void ngli_pgcraft_freep(struct pgcraft **sp);
 
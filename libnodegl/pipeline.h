@@ -75,6 +75,7 @@ struct pipeline_attribute_desc {
 
 struct pipeline_graphics {
     int topology;
+    int primitive_restart; // restart the primitives at the maximum value of the index type
     struct graphicstate state;
     struct rendertarget_desc rt_desc;
 };
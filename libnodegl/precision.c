@@ -19,7 +19,11 @@
  * under the License.
  */
 
+#include <math.h>
+#include <stdint.h>
+
 #include "precision.h"
+#include "type.h"
 #include "utils.h"
 
 const struct param_choices ngli_precision_choices = {
@@ -32,3 +36,91 @@ const struct param_choices ngli_precision_choices = {
         {NULL}
     }
 };
+
+#define LOWP_INT_MAX    ((1 << 8) - 1)
+#define MEDIUMP_INT_MAX ((1 << 10) - 1)
+#define MEDIUMP_MAX     16384.f
+
+/* Spacing between two mediump floats around v (half float representation) */
+static float get_mediump_spacing(float v)
+{
+    int exp;
+    frexpf(v, &exp);
+    return ldexpf(1.f, NGLI_MAX(exp, -13) - 11);
+}
+
+static int get_float_precision(float v)
+{
+    if (!isfinite(v) || fabsf(v) > MEDIUMP_MAX)
+        return NGLI_PRECISION_HIGH;
+
+    if (fabsf(v) < 2.f && v * 256.f == floorf(v * 256.f))
+        return NGLI_PRECISION_LOW;
+
+    const float spacing = get_mediump_spacing(v);
+    const float err = fabsf(v - roundf(v / spacing) * spacing);
+    return err <= NGLI_PRECISION_MAX_ERROR ? NGLI_PRECISION_MEDIUM : NGLI_PRECISION_HIGH;
+}
+
+static int get_int_precision(int64_t v)
+{
+    if (v >= -LOWP_INT_MAX && v <= LOWP_INT_MAX)
+        return NGLI_PRECISION_LOW;
+    if (v >= -MEDIUMP_INT_MAX && v <= MEDIUMP_INT_MAX)
+        return NGLI_PRECISION_MEDIUM;
+    return NGLI_PRECISION_HIGH;
+}
+
+int ngli_precision_get_lowest(int type, const void *data, int count)
+{
+    int nb_comp;
+    switch (type) {
+    case NGLI_TYPE_INT:
+    case NGLI_TYPE_UINT:
+    case NGLI_TYPE_FLOAT:  nb_comp = 1;  break;
+    case NGLI_TYPE_IVEC2:
+    case NGLI_TYPE_UIVEC2:
+    case NGLI_TYPE_VEC2:   nb_comp = 2;  break;
+    case NGLI_TYPE_IVEC3:
+    case NGLI_TYPE_UIVEC3:
+    case NGLI_TYPE_VEC3:   nb_comp = 3;  break;
+    case NGLI_TYPE_IVEC4:
+    case NGLI_TYPE_UIVEC4:
+    case NGLI_TYPE_VEC4:   nb_comp = 4;  break;
+    case NGLI_TYPE_MAT3:   nb_comp = 9;  break;
+    case NGLI_TYPE_MAT4:   nb_comp = 16; break;
+    default:
+        return NGLI_PRECISION_AUTO;
+    }
+
+    int precision = NGLI_PRECISION_LOW;
+    for (int i = 0; i < nb_comp * count; i++) {
+        int p;
+        if (type >= NGLI_TYPE_FLOAT)
+            p = get_float_precision(((const float *)data)[i]);
+        else if (type >= NGLI_TYPE_UINT)
+            p = get_int_precision(((const uint32_t *)data)[i]);
+        else
+            p = get_int_precision(((const int32_t *)data)[i]);
+        precision = NGLI_MIN(precision, p);
+        if (precision == NGLI_PRECISION_HIGH)
+            break;
+    }
+    return precision;
+}
+
+int ngli_precision_get_lowest_in_range(float min, float max)
+{
+    if (min == max)
+        return get_float_precision(min);
+
+    /*
+     * Any value of the range may be taken: the lowp absolute precision is
+     * never enough and the mediump one is limited by the largest magnitude
+     */
+    const float m = NGLI_MAX(fabsf(min), fabsf(max));
+    if (!isfinite(m) || m > MEDIUMP_MAX)
+        return NGLI_PRECISION_HIGH;
+    return get_mediump_spacing(m) / 2.f <= NGLI_PRECISION_MAX_ERROR ? NGLI_PRECISION_MEDIUM
+                                                                     : NGLI_PRECISION_HIGH;
+}
@@ -34,4 +34,26 @@ enum {
 
 extern const struct param_choices ngli_precision_choices;
 
+/*
+ * Largest absolute error tolerated on a value when the precision of a
+ * variable is derived from the values it can take
+ */
+#define NGLI_PRECISION_MAX_ERROR (1.f / 4096.f)
+
+/*
+ * Return the lowest precision representing the count elements of type (any
+ * of NGLI_TYPE_*) within NGLI_PRECISION_MAX_ERROR. The minimum requirements
+ * of GLSL ES are assumed: lowp floats have an absolute precision of 2^-8 on
+ * (-2,2), mediump floats a relative precision of 2^-10 on (-2^14,2^14), lowp
+ * and mediump integers the (-2^8,2^8) and (-2^10,2^10) ranges.
+ * NGLI_PRECISION_AUTO is returned for the types without precision.
+ */
+int ngli_precision_get_lowest(int type, const void *data, int count);
+
+/*
+ * Return the lowest float precision representing any value of [min,max]
+ * within NGLI_PRECISION_MAX_ERROR
+ */
+int ngli_precision_get_lowest_in_range(float min, float max);
+
 #endif
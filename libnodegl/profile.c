@@ -0,0 +1,155 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "bstr.h"
+#include "memory.h"
+#include "nodes.h"
+#include "profile.h"
+#include "utils.h"
+
+static const char * const phase_names[NGLI_PROFILE_PHASE_NB] = {
+    [NGLI_PROFILE_PHASE_SET_SCENE]      = "set_scene",
+    [NGLI_PROFILE_PHASE_FIRST_DRAW]     = "first_draw",
+    [NGLI_PROFILE_PHASE_INIT]           = "init",
+    [NGLI_PROFILE_PHASE_PREFETCH]       = "prefetch",
+    [NGLI_PROFILE_PHASE_SHADER_GEN]     = "shader_gen",
+    [NGLI_PROFILE_PHASE_SHADER_COMPILE] = "shader_compile",
+    [NGLI_PROFILE_PHASE_TEXTURE_UPLOAD] = "texture_upload",
+    [NGLI_PROFILE_PHASE_HWCONV_INIT]    = "hwconv_init",
+};
+
+void ngli_profile_init(struct profile *s)
+{
+    ngli_darray_init(&s->records, sizeof(struct profile_record), 0);
+}
+
+static void clear_records(struct profile *s)
+{
+    struct profile_record *records = ngli_darray_data(&s->records);
+    for (int i = 0; i < ngli_darray_count(&s->records); i++)
+        ngli_freep(&records[i].label);
+    ngli_darray_clear(&s->records);
+}
+
+void ngli_profile_start_recording(struct profile *s)
+{
+    clear_records(s);
+    s->depth = 0;
+    s->recording = 1;
+}
+
+void ngli_profile_stop_recording(struct profile *s)
+{
+    s->recording = 0;
+}
+
+void ngli_profile_start(struct profile *s, const struct ngl_node *node, int phase)
+{
+    if (!s->recording)
+        return;
+
+    if (s->depth < NGLI_PROFILE_MAX_DEPTH) {
+        if (!node && s->depth)
+            node = s->frames[s->depth - 1].node;
+        s->frames[s->depth] = (struct profile_frame){
+            .node       = node,
+            .phase      = phase,
+            .start_time = ngli_gettime_relative(),
+        };
+    }
+    s->depth++;
+}
+
+void ngli_profile_stop(struct profile *s)
+{
+    if (!s->recording || !s->depth)
+        return;
+
+    s->depth--;
+    if (s->depth >= NGLI_PROFILE_MAX_DEPTH)
+        return;
+
+    const struct profile_frame *frame = &s->frames[s->depth];
+    const int64_t time = ngli_gettime_relative() - frame->start_time;
+    if (s->depth)
+        s->frames[s->depth - 1].children_time += time;
+
+    const struct ngl_node *node = frame->node;
+    struct profile_record record = {
+        .class_name = node ? node->class->name : "",
+        .phase      = frame->phase,
+        .self_time  = time - frame->children_time,
+    };
+    /* a profiling failure is not worth failing the scene loading */
+    record.label = ngli_strdup(node && node->label ? node->label : "");
+    if (!record.label)
+        return;
+    if (!ngli_darray_push(&s->records, &record))
+        ngli_free(record.label);
+}
+
+/* Quote the field if needed, as described by RFC 4180 */
+static void print_csv_field(struct bstr *b, const char *field)
+{
+    if (!strpbrk(field, ",\"\r\n")) {
+        ngli_bstr_print(b, field);
+        return;
+    }
+
+    ngli_bstr_print(b, "\"");
+    for (const char *p = field; *p; p++)
+        ngli_bstr_printf(b, *p == '"' ? "\"\"" : "%c", *p);
+    ngli_bstr_print(b, "\"");
+}
+
+char *ngli_profile_get_report(const struct profile *s)
+{
+    struct bstr *b = ngli_bstr_create();
+    if (!b)
+        return NULL;
+
+    ngli_bstr_print(b, "label,type,phase,time_us\n");
+
+    const struct profile_record *records = ngli_darray_data(&s->records);
+    for (int i = 0; i < ngli_darray_count(&s->records); i++) {
+        const struct profile_record *record = &records[i];
+        print_csv_field(b, record->label);
+        ngli_bstr_printf(b, ",%s,%s,%" PRId64 "\n",
+                         record->class_name,
+                         phase_names[record->phase],
+                         record->self_time);
+    }
+
+    char *report = ngli_bstr_check(b) < 0 ? NULL : ngli_bstr_strdup(b);
+    ngli_bstr_freep(&b);
+    return report;
+}
+
+void ngli_profile_reset(struct profile *s)
+{
+    clear_records(s);
+    ngli_darray_reset(&s->records);
+    s->recording = 0;
+    s->depth = 0;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdint.h>
+
+#include "darray.h"
+
+struct ngl_node;
+
+enum {
+    NGLI_PROFILE_PHASE_SET_SCENE,
+    NGLI_PROFILE_PHASE_FIRST_DRAW,
+    NGLI_PROFILE_PHASE_INIT,
+    NGLI_PROFILE_PHASE_PREFETCH,
+    NGLI_PROFILE_PHASE_SHADER_GEN,
+    NGLI_PROFILE_PHASE_SHADER_COMPILE,
+    NGLI_PROFILE_PHASE_TEXTURE_UPLOAD,
+    NGLI_PROFILE_PHASE_HWCONV_INIT,
+    NGLI_PROFILE_PHASE_NB
+};
+
+#define NGLI_PROFILE_MAX_DEPTH 32
+
+/*
+ * The node label is copied (and the class name points to static storage)
+ * since the records outlive the scene they were measured on
+ */
+struct profile_record {
+    char *label;
+    const char *class_name;
+    int phase;
+    int64_t self_time;
+};
+
+struct profile_frame {
+    const struct ngl_node *node;
+    int phase;
+    int64_t start_time;
+    int64_t children_time;
+};
+
+/*
+ * Startup profile: time spent in each phase of the scene loading, from
+ * ngl_set_scene() to the end of the first draw. Phases can be nested (a
+ * shader compilation happens during the prefetch of a node); the recorded
+ * times exclude the nested phases so that they can be summed.
+ */
+struct profile {
+    int recording;
+    struct darray records; // struct profile_record
+    struct profile_frame frames[NGLI_PROFILE_MAX_DEPTH];
+    int depth;
+};
+
+void ngli_profile_init(struct profile *s);
+void ngli_profile_start_recording(struct profile *s);
+void ngli_profile_stop_recording(struct profile *s);
+
+/*
+ * Enter a phase for the given node; if node is NULL, the node of the
+ * enclosing phase is used.
+ */
+void ngli_profile_start(struct profile *s, const struct ngl_node *node, int phase);
+void ngli_profile_stop(struct profile *s);
+
+char *ngli_profile_get_report(const struct profile *s);
+void ngli_profile_reset(struct profile *s);
+
+#endif
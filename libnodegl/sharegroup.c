@@ -0,0 +1,164 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <pthread.h>
+
+#include "log.h"
+#include "memory.h"
+#include "sharegroup.h"
+
+struct shared_buffer {
+    struct buffer *buffer;
+    int refcount;
+};
+
+static void free_shared_buffer(void *user_arg, void *data)
+{
+    struct gctx *gctx = user_arg;
+    struct shared_buffer *shared_buffer = data;
+    if (shared_buffer->buffer)
+        shared_buffer->buffer->gctx = gctx;
+    ngli_buffer_freep(&shared_buffer->buffer);
+    ngli_free(shared_buffer);
+}
+
+struct sharegroup *ngli_sharegroup_create(struct gctx *gctx)
+{
+    struct sharegroup *s = ngli_calloc(1, sizeof(*s));
+    if (!s)
+        return NULL;
+
+    s->buffers = ngli_hmap_create();
+    if (!s->buffers) {
+        ngli_free(s);
+        return NULL;
+    }
+    ngli_hmap_set_free(s->buffers, free_shared_buffer, gctx);
+
+    if (ngli_pgcache_init(&s->pgcache, gctx) < 0) {
+        ngli_hmap_freep(&s->buffers);
+        ngli_free(s);
+        return NULL;
+    }
+
+    pthread_mutex_init(&s->lock, NULL);
+    s->refcount = 1;
+    return s;
+}
+
+struct sharegroup *ngli_sharegroup_ref(struct sharegroup *s)
+{
+    pthread_mutex_lock(&s->lock);
+    s->refcount++;
+    pthread_mutex_unlock(&s->lock);
+    return s;
+}
+
+void ngli_sharegroup_lock(struct sharegroup *s)
+{
+    pthread_mutex_lock(&s->lock);
+}
+
+void ngli_sharegroup_unlock(struct sharegroup *s)
+{
+    pthread_mutex_unlock(&s->lock);
+}
+
+int ngli_sharegroup_ref_buffer(struct sharegroup *s, struct gctx *gctx, const char *key, struct buffer **bufferp)
+{
+    int ret = 0;
+
+    pthread_mutex_lock(&s->lock);
+
+    struct shared_buffer *shared_buffer = ngli_hmap_get(s->buffers, key);
+    if (!shared_buffer) {
+        shared_buffer = ngli_calloc(1, sizeof(*shared_buffer));
+        if (!shared_buffer) {
+            ret = NGL_ERROR_MEMORY;
+            goto end;
+        }
+
+        shared_buffer->buffer = ngli_buffer_create(gctx);
+        if (!shared_buffer->buffer) {
+            ngli_free(shared_buffer);
+            ret = NGL_ERROR_MEMORY;
+            goto end;
+        }
+
+        ret = ngli_hmap_set(s->buffers, key, shared_buffer);
+        if (ret < 0) {
+            ngli_buffer_freep(&shared_buffer->buffer);
+            ngli_free(shared_buffer);
+            goto end;
+        }
+    }
+
+    shared_buffer->refcount++;
+    *bufferp = shared_buffer->buffer;
+
+end:
+    pthread_mutex_unlock(&s->lock);
+    return ret;
+}
+
+void ngli_sharegroup_unref_buffer(struct sharegroup *s, struct gctx *gctx, const char *key)
+{
+    pthread_mutex_lock(&s->lock);
+
+    struct shared_buffer *shared_buffer = ngli_hmap_get(s->buffers, key);
+    ngli_assert(shared_buffer && shared_buffer->refcount);
+    if (--shared_buffer->refcount == 0) {
+        /* the buffer is released with the graphics context of the caller */
+        ngli_hmap_set_free(s->buffers, free_shared_buffer, gctx);
+        ngli_hmap_set(s->buffers, key, NULL);
+    }
+
+    pthread_mutex_unlock(&s->lock);
+}
+
+void ngli_sharegroup_unrefp(struct sharegroup **sp, struct gctx *gctx)
+{
+    struct sharegroup *s = *sp;
+    if (!s)
+        return;
+
+    pthread_mutex_lock(&s->lock);
+    const int refcount = --s->refcount;
+    pthread_mutex_unlock(&s->lock);
+
+    if (refcount) {
+        /* the other contexts may outlive this one: stop charging it for the atlas */
+        ngli_sharegroup_lock(s);
+        if (s->font_atlas && s->font_atlas->memory_gctx == gctx)
+            ngli_texture_uncharge(s->font_atlas);
+        ngli_sharegroup_unlock(s);
+    } else {
+        ngli_pgcache_reset(&s->pgcache, gctx);
+        ngli_hmap_set_free(s->buffers, free_shared_buffer, gctx);
+        ngli_hmap_freep(&s->buffers);
+        if (s->font_atlas)
+            s->font_atlas->gctx = gctx;
+        ngli_texture_freep(&s->font_atlas);
+        pthread_mutex_destroy(&s->lock);
+        ngli_free(s);
+    }
+    *sp = NULL;
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2021 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef SHAREGROUP_H
+#define SHAREGROUP_H
+
+#include <pthread.h>
+
+#include "buffer.h"
+#include "gctx.h"
+#include "hmap.h"
+#include "pgcache.h"
+#include "texture.h"
+
+/*
+ * A share group holds the GPU resources which can be shared between all the
+ * contexts configured with a common parent (see ngl_config.share_ctx):
+ * programs, immutable buffers and the text font atlas. Every context of the
+ * group holds a reference on it; the resources are released with the
+ * graphics context of the last context leaving the group.
+ */
+struct sharegroup {
+    int refcount;
+    pthread_mutex_t lock;
+    struct pgcache pgcache;
+    struct hmap *buffers;
+    struct texture *font_atlas;
+};
+
+struct sharegroup *ngli_sharegroup_create(struct gctx *gctx);
+struct sharegroup *ngli_sharegroup_ref(struct sharegroup *s);
+void ngli_sharegroup_lock(struct sharegroup *s);
+void ngli_sharegroup_unlock(struct sharegroup *s);
+int ngli_sharegroup_ref_buffer(struct sharegroup *s, struct gctx *gctx, const char *key, struct buffer **bufferp);
+void ngli_sharegroup_unref_buffer(struct sharegroup *s, struct gctx *gctx, const char *key);
+void ngli_sharegroup_unrefp(struct sharegroup **sp, struct gctx *gctx);
+
+#endif
@@ -0,0 +1,130 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string.h>
+
+#include "format.h"
+#include "ktx2.h"
+#include "utils.h"
+
+#define HEADER_SIZE 80
+#define DATA_OFFSET (HEADER_SIZE + 2 * 24)
+
+static void write_u32(uint8_t *p, uint32_t v)
+{
+    for (int i = 0; i < 4; i++)
+        p[i] = v >> (8 * i);
+}
+
+static void write_u64(uint8_t *p, uint64_t v)
+{
+    write_u32(p, (uint32_t)v);
+    write_u32(p + 4, v >> 32);
+}
+
+/* 4x4 BC1 image with 2 levels: red, blue and their 2 interpolations */
+static void build_bc1_file(uint8_t *data)
+{
+    static const uint8_t identifier[12] = {
+        0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n',
+    };
+    static const uint8_t block[8] = {
+        0x00, 0xF8,             /* c0: red (565) */
+        0x1F, 0x00,             /* c1: blue (565) */
+        0xE4, 0x00, 0x00, 0x00, /* indices: 0, 1, 2, 3 on the first row */
+    };
+
+    memcpy(data, identifier, sizeof(identifier));
+    write_u32(data + 12, 133); /* VK_FORMAT_BC1_RGBA_UNORM_BLOCK */
+    write_u32(data + 16, 1);   /* typeSize */
+    write_u32(data + 20, 4);   /* pixelWidth */
+    write_u32(data + 24, 4);   /* pixelHeight */
+    write_u32(data + 36, 1);   /* faceCount */
+    write_u32(data + 40, 2);   /* levelCount */
+
+    write_u64(data + HEADER_SIZE,           DATA_OFFSET);
+    write_u64(data + HEADER_SIZE + 8,       sizeof(block));
+    write_u64(data + HEADER_SIZE + 24,      DATA_OFFSET + sizeof(block));
+    write_u64(data + HEADER_SIZE + 24 + 8,  sizeof(block));
+
+    memcpy(data + DATA_OFFSET, block, sizeof(block));
+    memcpy(data + DATA_OFFSET + sizeof(block), block, sizeof(block));
+}
+
+int main(void)
+{
+    uint8_t data[DATA_OFFSET + 2 * 8] = {0};
+    build_bc1_file(data);
+
+    struct ktx2 ktx2 = {0};
+    int ret = ngli_ktx2_parse(&ktx2, data, sizeof(data));
+    ngli_assert(ret == 0);
+    ngli_assert(ktx2.format == NGLI_FORMAT_BC1_RGBA_UNORM_BLOCK);
+    ngli_assert(ktx2.width == 4 && ktx2.height == 4);
+    ngli_assert(ktx2.nb_levels == 2);
+    ngli_assert(ktx2.levels[1].width == 2 && ktx2.levels[1].height == 2);
+    ngli_assert(ktx2.levels[1].size == 8);
+
+    static const uint8_t expected[4][4] = {
+        {255,   0,   0, 255},
+        {  0,   0, 255, 255},
+        {170,   0,  85, 255},
+        { 85,   0, 170, 255},
+    };
+
+    uint8_t rgba[4 * 4 * 4];
+    ngli_assert(ngli_ktx2_get_transcode_format(ktx2.format) == NGLI_FORMAT_R8G8B8A8_UNORM);
+    ret = ngli_ktx2_transcode_level(&ktx2, 0, rgba);
+    ngli_assert(ret == 0);
+    ngli_assert(!memcmp(rgba, expected, sizeof(expected)));
+    for (int i = 4; i < 16; i++)
+        ngli_assert(!memcmp(rgba + i * 4, expected[0], 4));
+
+    /* the 2x2 level only keeps the top-left corner of the block */
+    memset(rgba, 0, sizeof(rgba));
+    ret = ngli_ktx2_transcode_level(&ktx2, 1, rgba);
+    ngli_assert(ret == 0);
+    ngli_assert(!memcmp(rgba, expected, 2 * 4));
+    ngli_assert(!memcmp(rgba + 2 * 4, expected[0], 4));
+    ngli_assert(!memcmp(rgba + 3 * 4, expected[0], 4));
+
+    /* supercompressed and truncated files are rejected */
+    write_u32(data + 44, 1);
+    ngli_assert(ngli_ktx2_parse(&ktx2, data, sizeof(data)) < 0);
+    write_u32(data + 44, 0);
+    ngli_assert(ngli_ktx2_parse(&ktx2, data, sizeof(data) - 1) < 0);
+    data[0] = 0;
+    ngli_assert(ngli_ktx2_parse(&ktx2, data, sizeof(data)) < 0);
+
+    /* a level size overflowing an int must not wrap to the declared length */
+    build_bc1_file(data);
+    write_u32(data + 12, 37); /* VK_FORMAT_R8G8B8A8_UNORM */
+    write_u32(data + 20, 32768);
+    write_u32(data + 24, 32768);
+    write_u32(data + 40, 1);
+    write_u64(data + HEADER_SIZE, HEADER_SIZE + 24);
+    write_u64(data + HEADER_SIZE + 8, 0);
+    ngli_assert(ngli_ktx2_parse(&ktx2, data, HEADER_SIZE + 24) < 0);
+
+    ngli_ktx2_reset(&ktx2);
+
+    return 0;
+}
@@ -0,0 +1,339 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "memory.h"
+#include "meshopt.h"
+#include "utils.h"
+
+#define GRID_SIZE    48
+#define NB_VERTICES  ((GRID_SIZE + 1) * (GRID_SIZE + 1))
+#define NB_TRIANGLES (GRID_SIZE * GRID_SIZE * 2)
+#define NB_INDICES   (NB_TRIANGLES * 3)
+
+/* Sphere-like grid with its triangles shuffled to defeat the vertex cache */
+static void gen_mesh(float *positions, uint32_t *indices)
+{
+    for (int y = 0; y <= GRID_SIZE; y++) {
+        for (int x = 0; x <= GRID_SIZE; x++) {
+            float *p = positions + (y * (GRID_SIZE + 1) + x) * 3;
+            const float fx = x / (float)GRID_SIZE - .5f;
+            const float fy = y / (float)GRID_SIZE - .5f;
+            p[0] = fx;
+            p[1] = fy;
+            p[2] = 1.f - fx * fx - fy * fy;
+        }
+    }
+
+    uint32_t *p = indices;
+    for (int y = 0; y < GRID_SIZE; y++) {
+        for (int x = 0; x < GRID_SIZE; x++) {
+            const uint32_t i0 = y * (GRID_SIZE + 1) + x;
+            const uint32_t i1 = i0 + 1;
+            const uint32_t i2 = i0 + GRID_SIZE + 1;
+            const uint32_t i3 = i2 + 1;
+            *p++ = i0; *p++ = i1; *p++ = i2;
+            *p++ = i2; *p++ = i1; *p++ = i3;
+        }
+    }
+
+    uint32_t seed = 0x12345678;
+    for (int i = NB_TRIANGLES - 1; i > 0; i--) {
+        seed = seed * 1664525 + 1013904223;
+        const int j = (seed >> 8) % (i + 1);
+        uint32_t tmp[3];
+        memcpy(tmp, indices + i * 3, sizeof(tmp));
+        memcpy(indices + i * 3, indices + j * 3, sizeof(tmp));
+        memcpy(indices + j * 3, tmp, sizeof(tmp));
+    }
+}
+
+static int cmp_triangle(const void *a, const void *b)
+{
+    return memcmp(a, b, 3 * sizeof(uint32_t));
+}
+
+/* Rotate each triangle so it starts with its lowest index (winding preserved) and sort them */
+static void canonicalize(uint32_t *dst, const uint32_t *indices)
+{
+    for (int i = 0; i < NB_TRIANGLES; i++) {
+        const uint32_t *t = indices + i * 3;
+        const int r = t[0] < t[1] ? (t[0] < t[2] ? 0 : 2) : (t[1] < t[2] ? 1 : 2);
+        for (int k = 0; k < 3; k++)
+            dst[i * 3 + k] = t[(r + k) % 3];
+    }
+    qsort(dst, NB_TRIANGLES, 3 * sizeof(*dst), cmp_triangle);
+}
+
+static void check_same_triangles(const uint32_t *a, const uint32_t *b)
+{
+    uint32_t *ca = ngli_calloc(NB_INDICES, sizeof(*ca));
+    uint32_t *cb = ngli_calloc(NB_INDICES, sizeof(*cb));
+    ngli_assert(ca && cb);
+    canonicalize(ca, a);
+    canonicalize(cb, b);
+    ngli_assert(!memcmp(ca, cb, NB_INDICES * sizeof(*ca)));
+    ngli_free(ca);
+    ngli_free(cb);
+}
+
+/* Same occlusion sort key as the overdraw optimizer */
+static float get_cluster_sort_key(const uint32_t *indices, int nb_triangles,
+                                  const float *positions, const float *mesh_centroid)
+{
+    float centroid[3] = {0};
+    float normal_sum[3] = {0};
+    float area_sum = 0.f;
+    for (int i = 0; i < nb_triangles; i++) {
+        const float *p0 = positions + indices[i * 3 + 0] * 3;
+        const float *p1 = positions + indices[i * 3 + 1] * 3;
+        const float *p2 = positions + indices[i * 3 + 2] * 3;
+        const float u[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+        const float v[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+        const float normal[3] = {
+            u[1] * v[2] - u[2] * v[1],
+            u[2] * v[0] - u[0] * v[2],
+            u[0] * v[1] - u[1] * v[0],
+        };
+        const float area = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        for (int k = 0; k < 3; k++) {
+            centroid[k] += area * (p0[k] + p1[k] + p2[k]) / 3.f;
+            normal_sum[k] += normal[k];
+        }
+        area_sum += area;
+    }
+
+    const float normal_len = sqrtf(normal_sum[0] * normal_sum[0] +
+                                   normal_sum[1] * normal_sum[1] +
+                                   normal_sum[2] * normal_sum[2]);
+    if (area_sum <= 0.f || normal_len <= 0.f)
+        return 0.f;
+
+    float sort_key = 0.f;
+    for (int k = 0; k < 3; k++)
+        sort_key += (centroid[k] / area_sum - mesh_centroid[k]) * normal_sum[k] / normal_len;
+    return sort_key;
+}
+
+/*
+ * The clusters of the cache optimized input must be found contiguous in the
+ * output, sorted by decreasing occlusion sort key
+ */
+static void check_overdraw_clusters(const uint32_t *vcache, const uint32_t *overdraw, const float *positions)
+{
+    int *starts = ngli_calloc(NB_TRIANGLES, sizeof(*starts));
+    int *offsets = ngli_calloc(NB_TRIANGLES, sizeof(*offsets));
+    float *keys = ngli_calloc(NB_TRIANGLES, sizeof(*keys));
+    ngli_assert(starts && offsets && keys);
+
+    const int nb_clusters = ngli_meshopt_get_overdraw_clusters(starts, vcache, NB_INDICES, NB_VERTICES);
+    ngli_assert(nb_clusters > 0 && starts[0] == 0);
+
+    /* a cache optimized grid has few hard boundaries: most clusters come from the ACMR split */
+    printf("overdraw: %d clusters\n", nb_clusters);
+    ngli_assert(nb_clusters >= 16);
+
+    float mesh_centroid[3] = {0};
+    float mesh_area = 0.f;
+    for (int i = 0; i < NB_TRIANGLES; i++) {
+        const float *p0 = positions + vcache[i * 3 + 0] * 3;
+        const float *p1 = positions + vcache[i * 3 + 1] * 3;
+        const float *p2 = positions + vcache[i * 3 + 2] * 3;
+        const float u[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+        const float v[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+        const float n[3] = {u[1] * v[2] - u[2] * v[1], u[2] * v[0] - u[0] * v[2], u[0] * v[1] - u[1] * v[0]};
+        const float area = sqrtf(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        for (int k = 0; k < 3; k++)
+            mesh_centroid[k] += area * (p0[k] + p1[k] + p2[k]) / 3.f;
+        mesh_area += area;
+    }
+    for (int k = 0; k < 3; k++)
+        mesh_centroid[k] /= mesh_area;
+
+    int reordered = 0;
+    for (int c = 0; c < nb_clusters; c++) {
+        const int start = starts[c];
+        const int nb_triangles = (c + 1 < nb_clusters ? starts[c + 1] : NB_TRIANGLES) - start;
+        ngli_assert(nb_triangles > 0);
+        keys[c] = get_cluster_sort_key(vcache + start * 3, nb_triangles, positions, mesh_centroid);
+
+        /* locate the cluster in the output */
+        offsets[c] = -1;
+        for (int i = 0; i + nb_triangles <= NB_TRIANGLES; i++) {
+            if (!memcmp(overdraw + i * 3, vcache + start * 3, nb_triangles * 3 * sizeof(*vcache))) {
+                offsets[c] = i;
+                break;
+            }
+        }
+        ngli_assert(offsets[c] >= 0);
+        reordered |= offsets[c] != start;
+    }
+    ngli_assert(reordered);
+
+    for (int c0 = 0; c0 < nb_clusters; c0++)
+        for (int c1 = 0; c1 < nb_clusters; c1++)
+            if (offsets[c0] < offsets[c1])
+                ngli_assert(keys[c0] >= keys[c1] - 1e-6f);
+
+    ngli_free(keys);
+    ngli_free(offsets);
+    ngli_free(starts);
+}
+
+static float get_acmr(const uint32_t *indices)
+{
+    const int nb_misses = ngli_meshopt_get_cache_misses(indices, NB_INDICES, NB_VERTICES,
+                                                        NGLI_MESHOPT_CACHE_SIZE);
+    ngli_assert(nb_misses >= 0);
+    return nb_misses / (float)NB_TRIANGLES;
+}
+
+int main(void)
+{
+    float *positions = ngli_calloc(NB_VERTICES * 3, sizeof(*positions));
+    uint32_t *indices = ngli_calloc(NB_INDICES, sizeof(*indices));
+    uint32_t *vcache = ngli_calloc(NB_INDICES, sizeof(*vcache));
+    uint32_t *overdraw = ngli_calloc(NB_INDICES, sizeof(*overdraw));
+    uint32_t *remap = ngli_calloc(NB_VERTICES, sizeof(*remap));
+    ngli_assert(positions && indices && vcache && overdraw && remap);
+
+    gen_mesh(positions, indices);
+
+    /* cache simulator sanity checks */
+    const uint32_t strip[] = {0, 1, 2, 2, 1, 3, 2, 3, 4};
+    ngli_assert(ngli_meshopt_get_cache_misses(strip, 9, 5, 16) == 5);
+    ngli_assert(ngli_meshopt_get_cache_misses(strip, 9, 5, 1) == 8);
+    ngli_assert(ngli_meshopt_get_cache_misses(strip, 9, 4, 16) < 0);
+
+    const float acmr_ref = get_acmr(indices);
+
+    int ret = ngli_meshopt_optimize_vertex_cache(vcache, indices, NB_INDICES, NB_VERTICES);
+    ngli_assert(ret == 0);
+    check_same_triangles(indices, vcache);
+    const float acmr_vcache = get_acmr(vcache);
+
+    ret = ngli_meshopt_optimize_overdraw(overdraw, vcache, NB_INDICES, positions, NB_VERTICES);
+    ngli_assert(ret == 0);
+    check_same_triangles(indices, overdraw);
+    const float acmr_overdraw = get_acmr(overdraw);
+    check_overdraw_clusters(vcache, overdraw, positions);
+
+    printf("ACMR: shuffled=%.3f vertex_cache=%.3f overdraw=%.3f\n",
+           acmr_ref, acmr_vcache, acmr_overdraw);
+    ngli_assert(acmr_ref > 2.f);
+    ngli_assert(acmr_vcache < 0.8f);
+    ngli_assert(acmr_overdraw < acmr_vcache * 1.05f);
+
+    /* vertex fetch: the vertices are renumbered in their order of first use */
+    uint32_t *fetch = ngli_calloc(NB_INDICES, sizeof(*fetch));
+    float *remapped_positions = ngli_calloc(NB_VERTICES * 3, sizeof(*remapped_positions));
+    ngli_assert(fetch && remapped_positions);
+    memcpy(fetch, overdraw, NB_INDICES * sizeof(*fetch));
+    memcpy(remapped_positions, positions, NB_VERTICES * 3 * sizeof(*positions));
+
+    ret = ngli_meshopt_optimize_vertex_fetch(remap, fetch, NB_INDICES, NB_VERTICES);
+    ngli_assert(ret == 0);
+    ret = ngli_meshopt_remap_vertices(remapped_positions, NB_VERTICES, 3 * sizeof(float), remap);
+    ngli_assert(ret == 0);
+
+    uint32_t next = 0;
+    for (int i = 0; i < NB_INDICES; i++) {
+        ngli_assert(fetch[i] <= next);
+        if (fetch[i] == next)
+            next++;
+        ngli_assert(!memcmp(remapped_positions + fetch[i] * 3, positions + overdraw[i] * 3, 3 * sizeof(float)));
+    }
+    ngli_assert(next == NB_VERTICES);
+    ngli_assert(get_acmr(fetch) == acmr_overdraw);
+
+    /* strips: the decoded triangles must match the list, winding included */
+    uint32_t *strip_indices = ngli_calloc(NB_TRIANGLES * 4, sizeof(*strip_indices));
+    uint32_t *decoded = ngli_calloc(NB_INDICES, sizeof(*decoded));
+    ngli_assert(strip_indices && decoded);
+    const int nb_strip_indices = ngli_meshopt_convert_to_strip(strip_indices, vcache, NB_INDICES, UINT32_MAX);
+    ngli_assert(nb_strip_indices > 0 && nb_strip_indices <= NB_TRIANGLES * 4);
+
+    int nb_decoded = 0;
+    int strip_start = 0;
+    for (int i = 0; i <= nb_strip_indices; i++) {
+        if (i < nb_strip_indices && strip_indices[i] != UINT32_MAX)
+            continue;
+        for (int k = strip_start; k + 2 < i; k++) {
+            const int odd = (k - strip_start) & 1;
+            ngli_assert(nb_decoded + 3 <= NB_INDICES);
+            decoded[nb_decoded++] = strip_indices[k + odd];
+            decoded[nb_decoded++] = strip_indices[k + 1 - odd];
+            decoded[nb_decoded++] = strip_indices[k + 2];
+        }
+        strip_start = i + 1;
+    }
+    ngli_assert(nb_decoded == NB_INDICES);
+    check_same_triangles(vcache, decoded);
+    printf("strip: %d indices for %d in the list\n", nb_strip_indices, NB_INDICES);
+    ngli_assert(nb_strip_indices < NB_INDICES);
+    ngli_free(decoded);
+    ngli_free(strip_indices);
+
+    /* half float conversion: exact values, rounding, subnormals and overflow */
+    ngli_assert(ngli_meshopt_float_to_half(1.f) == 0x3c00);
+    ngli_assert(ngli_meshopt_float_to_half(-2.f) == 0xc000);
+    ngli_assert(ngli_meshopt_float_to_half(65504.f) == 0x7bff);
+    ngli_assert(ngli_meshopt_float_to_half(65520.f) == 0x7c00);
+    ngli_assert(ngli_meshopt_float_to_half(1.f + 1.f / 2048.f) == 0x3c00);
+    ngli_assert(ngli_meshopt_float_to_half(1.f + 3.f / 2048.f) == 0x3c02);
+    ngli_assert(ngli_meshopt_float_to_half(ldexpf(1.f, -24)) == 0x0001);
+    ngli_assert(ngli_meshopt_float_to_half(ldexpf(1.f, -14)) == 0x0400);
+    for (int i = 0; i < 0x7c00; i++)
+        ngli_assert(ngli_meshopt_float_to_half(ngli_meshopt_half_to_float(i)) == i);
+
+    /* quantization error bounds */
+    uint8_t quantized[NB_VERTICES * 8];
+    const float half_error = ngli_meshopt_quantize_half(quantized, 8, positions, 3, NB_VERTICES);
+    ngli_assert(half_error <= 1.f / 2048.f);
+    ngli_assert(ngli_meshopt_half_to_float(*(uint16_t *)(quantized + 6)) == 1.f);
+    const float huge[] = {0.f, 1e5f, 0.f};
+    ngli_assert(isinf(ngli_meshopt_quantize_half(NULL, 0, huge, 3, 1)));
+
+    const float normals[] = {0.f, 0.f, 1.f, -1.f, 0.f, 0.f, .6f, -.8f, 0.f};
+    ngli_assert(ngli_meshopt_quantize_snorm8(quantized, 4, normals, 3, 3) <= .5f / 127.f);
+    ngli_assert(quantized[2] == 127 && (int8_t)quantized[4] == -127 && quantized[3] == 0);
+    ngli_assert(ngli_meshopt_quantize_snorm8(NULL, 0, huge, 3, 1) > 1.f);
+
+    const float uvcoords[] = {0.f, 1.f, .25f, .75f, 1.f / 3.f, .5f};
+    ngli_assert(ngli_meshopt_quantize_unorm16(quantized, 4, uvcoords, 2, 3) <= .5f / 65535.f);
+    ngli_assert(*(uint16_t *)(quantized + 2) == 65535);
+    const float uv_outside[] = {-.5f, 2.f};
+    ngli_assert(ngli_meshopt_quantize_unorm16(NULL, 0, uv_outside, 2, 1) >= .5f);
+
+    ngli_free(fetch);
+    ngli_free(remapped_positions);
+    ngli_free(remap);
+    ngli_free(overdraw);
+    ngli_free(vcache);
+    ngli_free(indices);
+    ngli_free(positions);
+
+    return 0;
+}
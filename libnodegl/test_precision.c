@@ -0,0 +1,113 @@
+/*
+ * Copyright 2020 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "precision.h"
+#include "type.h"
+#include "utils.h"
+
+#define HIGH   NGLI_PRECISION_HIGH
+#define MEDIUM NGLI_PRECISION_MEDIUM
+#define LOW    NGLI_PRECISION_LOW
+
+static int get_float(float v)
+{
+    return ngli_precision_get_lowest(NGLI_TYPE_FLOAT, &v, 1);
+}
+
+/* Brute force check of the mediump error bound on a value */
+static void check_mediump(float v)
+{
+    if (get_float(v) != MEDIUM)
+        return;
+    int exp;
+    frexpf(v, &exp);
+    const float spacing = ldexpf(1.f, NGLI_MAX(exp, -13) - 11);
+    const float rounded = roundf(v / spacing) * spacing;
+    ngli_assert(fabsf(v - rounded) <= NGLI_PRECISION_MAX_ERROR);
+    ngli_assert(fabsf(rounded) <= 16384.f);
+}
+
+int main(void)
+{
+    /* lowp: multiples of 2^-8 within (-2,2) */
+    ngli_assert(get_float(0.f) == LOW);
+    ngli_assert(get_float(1.f) == LOW);
+    ngli_assert(get_float(-.5f) == LOW);
+    ngli_assert(get_float(1.f / 256.f) == LOW);
+    ngli_assert(get_float(2.f) == MEDIUM);
+
+    /* mediump: within the error bound of a half float */
+    ngli_assert(get_float(.3f) == MEDIUM);
+    ngli_assert(get_float(-.9f) == MEDIUM);
+    ngli_assert(get_float(1.0005f) == HIGH);
+    ngli_assert(get_float(3.25f) == MEDIUM);
+    ngli_assert(get_float(1000.f) == MEDIUM);
+    ngli_assert(get_float(16384.f) == MEDIUM);
+    ngli_assert(get_float(16385.f) == HIGH);
+    ngli_assert(get_float(1e-6f) == MEDIUM);
+    ngli_assert(get_float(NAN) == HIGH);
+    ngli_assert(get_float(INFINITY) == HIGH);
+
+    for (int i = -4096; i <= 4096; i++)
+        check_mediump(i / 1000.f);
+
+    /* the lowest precision of a set is the one of its most demanding value */
+    const float color[] = {1.f, .5f, 0.f, 1.f};
+    ngli_assert(ngli_precision_get_lowest(NGLI_TYPE_VEC4, color, 1) == LOW);
+    const float positions[] = {-.5f, -.5f, 0.f, .5f, -.5f, 0.f, .3f, .5f, 0.f};
+    ngli_assert(ngli_precision_get_lowest(NGLI_TYPE_VEC3, positions, 3) == MEDIUM);
+    const float mat[16] = {1.f, [5] = 1.f, [10] = 1.f, [12] = 100.1f, [15] = 1.f};
+    ngli_assert(ngli_precision_get_lowest(NGLI_TYPE_MAT4, mat, 1) == HIGH);
+
+    /* integers */
+    const int32_t ivec[] = {-255, 255, 0, 3};
+    ngli_assert(ngli_precision_get_lowest(NGLI_TYPE_IVEC4, ivec, 1) == LOW);
+    const int32_t ivec_medium[] = {-1023, 256};
+    ngli_assert(ngli_precision_get_lowest(NGLI_TYPE_IVEC2, ivec_medium, 1) == MEDIUM);
+    const int32_t int_high = -1024;
+    ngli_assert(ngli_precision_get_lowest(NGLI_TYPE_INT, &int_high, 1) == HIGH);
+    const uint32_t uint_high = 0xffffffff;
+    ngli_assert(ngli_precision_get_lowest(NGLI_TYPE_UINT, &uint_high, 1) == HIGH);
+
+    /* types without precision */
+    const int32_t b = 1;
+    ngli_assert(ngli_precision_get_lowest(NGLI_TYPE_BOOL, &b, 1) == NGLI_PRECISION_AUTO);
+
+    /* ranges: any interpolated value may be taken */
+    ngli_assert(ngli_precision_get_lowest_in_range(0.f, .9f) == MEDIUM);
+    ngli_assert(ngli_precision_get_lowest_in_range(-.99f, .5f) == MEDIUM);
+    ngli_assert(ngli_precision_get_lowest_in_range(0.f, 1.f) == HIGH);
+    ngli_assert(ngli_precision_get_lowest_in_range(0.f, 10.f) == HIGH);
+    ngli_assert(ngli_precision_get_lowest_in_range(.5f, .5f) == LOW);
+    for (int i = 0; i < 1000; i++) {
+        const float v = i / 1000.f * .999f;
+        if (ngli_precision_get_lowest_in_range(0.f, .999f) == MEDIUM)
+            check_mediump(v);
+        ngli_assert(get_float(v) >= MEDIUM);
+    }
+
+    printf("precision checks passed\n");
+    return 0;
+}
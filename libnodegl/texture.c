@@ -19,6 +19,7 @@
  * under the License.
  */
 
+#include "format.h"
 #include "gctx.h"
 #include "texture.h"
 
@@ -27,9 +28,32 @@ struct texture *ngli_texture_create(struct gctx *gctx)
     return gctx->class->texture_create(gctx);
 }
 
+static int64_t get_memory_size(const struct texture *s)
+{
+    const struct texture_params *params = &s->params;
+
+    if (s->external_storage)
+        return 0;
+
+    int64_t size = ngli_format_get_image_size(params->format, params->width, params->height);
+    size *= NGLI_MAX(params->depth, 1) * NGLI_MAX(params->samples, 1);
+    if (params->type == NGLI_TEXTURE_TYPE_CUBE)
+        size *= 6;
+    if (params->nb_levels > 1 || (!params->nb_levels && params->mipmap_filter != NGLI_MIPMAP_FILTER_NONE))
+        size += size / 3;
+    return size;
+}
+
 int ngli_texture_init(struct texture *s, const struct texture_params *params)
 {
-    return s->gctx->class->texture_init(s, params);
+    int ret = s->gctx->class->texture_init(s, params);
+    if (ret < 0)
+        return ret;
+    ngli_texture_uncharge(s);
+    s->memory_size = get_memory_size(s);
+    s->memory_gctx = s->gctx;
+    s->memory_gctx->memory_usage += s->memory_size;
+    return 0;
 }
 
 int ngli_texture_has_mipmap(const struct texture *s)
@@ -47,14 +71,48 @@ int ngli_texture_upload(struct texture *s, const uint8_t *data, int linesize)
     return s->gctx->class->texture_upload(s, data, linesize);
 }
 
+int ngli_texture_upload_compressed(struct texture *s, int level, const uint8_t *data, int size)
+{
+    return s->gctx->class->texture_upload_compressed(s, level, data, size);
+}
+
 int ngli_texture_generate_mipmap(struct texture *s)
 {
+    s->mipmap_dirty = 0;
     return s->gctx->class->texture_generate_mipmap(s);
 }
 
+/*
+ * Mipmap generation is deferred until the texture is actually sampled:
+ * textures updated several times between two draws, or not used at all in
+ * the frame, do not pay the cost of the generation.
+ */
+void ngli_texture_invalidate_mipmap(struct texture *s)
+{
+    if (ngli_texture_has_mipmap(s))
+        s->mipmap_dirty = 1;
+}
+
+int ngli_texture_update_mipmap(struct texture *s)
+{
+    if (!s->mipmap_dirty)
+        return 0;
+    return ngli_texture_generate_mipmap(s);
+}
+
+/* See ngli_buffer_uncharge() */
+void ngli_texture_uncharge(struct texture *s)
+{
+    if (!s->memory_gctx)
+        return;
+    s->memory_gctx->memory_usage -= s->memory_size;
+    s->memory_gctx = NULL;
+}
+
 void ngli_texture_freep(struct texture **sp)
 {
     if (!*sp)
         return;
+    ngli_texture_uncharge(*sp);
     (*sp)->gctx->class->texture_freep(sp);
 }
@@ -81,6 +81,7 @@ struct texture_params {
     int wrap_r;
     int immutable;
     int usage;
+    int nb_levels; // number of levels of the immutable storage, 0 to derive it from mipmap_filter
     int external_storage;
     int external_oes;
     int rectangle;
@@ -92,6 +93,9 @@ struct texture {
     int wrapped;
     int external_storage;
     int bytes_per_pixel;
+    int mipmap_dirty; // mipmap levels are outdated and must be regenerated before being sampled
+    int64_t memory_size;       // size accounted in the memory usage of memory_gctx
+    struct gctx *memory_gctx;  // context charged with the memory of the texture, if any
 };
 
 struct texture *ngli_texture_create(struct gctx *gctx);
@@ -103,8 +107,12 @@ int ngli_texture_has_mipmap(const struct texture *s);
 int ngli_texture_match_dimensions(const struct texture *s, int width, int height, int depth);
 
 int ngli_texture_upload(struct texture *s, const uint8_t *data, int linesize);
+int ngli_texture_upload_compressed(struct texture *s, int level, const uint8_t *data, int size);
 int ngli_texture_generate_mipmap(struct texture *s);
+void ngli_texture_invalidate_mipmap(struct texture *s);
+int ngli_texture_update_mipmap(struct texture *s);
 
+void ngli_texture_uncharge(struct texture *s);
 void ngli_texture_freep(struct texture **sp);
 
 #endif
@@ -23,9 +23,10 @@
 #include "log.h"
 #include "nodegl.h"
 #include "math_utils.h"
+#include "nodes.h"
 #include "transforms.h"
 
-const float *ngli_get_last_transformation_matrix(const struct ngl_node *node)
+int ngli_transform_chain_check(const struct ngl_node *node)
 {
     while (node) {
         const int id = node->class->id;
@@ -40,18 +41,76 @@ const float *ngli_get_last_transformation_matrix(const struct ngl_node *node)
                 node = trf->child;
                 break;
             }
-            case NGL_NODE_IDENTITY: {
-                const struct identity_priv *identity = node->priv_data;
-                return identity->modelview_matrix;
-            }
+            case NGL_NODE_IDENTITY:
+                return 0;
             default:
-                LOG(ERROR, "%s (%s) is not an allowed type for a camera transformation",
+                LOG(ERROR, "%s (%s) is not an allowed type for a transformation chain",
                     node->label, node->class->name);
-                break;
+                return NGL_ERROR_INVALID_ARG;
         }
     }
 
-    return NULL;
+    return 0;
+}
+
+int ngli_transform_chain_is_static(const struct ngl_node *node)
+{
+    while (node && node->class->id != NGL_NODE_IDENTITY) {
+        const struct transform_priv *trf = node->priv_data;
+        if (!trf->is_static)
+            return 0;
+        node = trf->child;
+    }
+    return 1;
+}
+
+void ngli_transform_chain_compute(const struct ngl_node *node, float *matrix)
+{
+    ngli_mat4_identity(matrix);
+    while (node && node->class->id != NGL_NODE_IDENTITY) {
+        const struct transform_priv *trf = node->priv_data;
+        ngli_mat4_mul(matrix, matrix, trf->matrix);
+        node = trf->child;
+    }
+}
+
+void ngli_transform_set_static(struct ngl_node *node, int is_static)
+{
+    struct transform_priv *s = node->priv_data;
+    s->is_static = is_static;
+    s->folded_child = NULL;
+}
+
+void ngli_transform_invalidate_static(struct ngl_node *node)
+{
+    /*
+     * The parents of a node are unknown, so any live change of a static
+     * transform invalidates all the folded chains of the context.
+     */
+    node->ctx->static_transforms_rev++;
+}
+
+static int is_static_transform(const struct ngl_node *node)
+{
+    if (node->class->draw != ngli_transform_draw)
+        return 0;
+    const struct transform_priv *s = node->priv_data;
+    return s->is_static;
+}
+
+static void fold_static_chain(struct transform_priv *s, int64_t rev)
+{
+    struct ngl_node *child = s->child;
+
+    memcpy(s->folded_matrix, s->matrix, sizeof(s->folded_matrix));
+    while (is_static_transform(child)) {
+        const struct transform_priv *trf = child->priv_data;
+        ngli_mat4_mul(s->folded_matrix, s->folded_matrix, trf->matrix);
+        child = trf->child;
+    }
+
+    s->folded_child = child;
+    s->folded_rev = rev;
 }
 
 void ngli_transform_draw(struct ngl_node *node)
@@ -59,6 +118,18 @@ void ngli_transform_draw(struct ngl_node *node)
     struct ngl_ctx *ctx = node->ctx;
     struct transform_priv *s = node->priv_data;
     struct ngl_node *child = s->child;
+    const float *matrix = s->matrix;
+
+    /*
+     * Consecutive static transforms are folded into a single matrix so that
+     * the nodes of the chain are not individually drawn.
+     */
+    if (s->is_static) {
+        if (!s->folded_child || s->folded_rev != ctx->static_transforms_rev)
+            fold_static_chain(s, ctx->static_transforms_rev);
+        child = s->folded_child;
+        matrix = s->folded_matrix;
+    }
 
     float *next_matrix = ngli_darray_push(&ctx->modelview_matrix_stack, NULL);
     if (!next_matrix)
@@ -69,7 +140,7 @@ void ngli_transform_draw(struct ngl_node *node)
      * underlying matrix stack buffer */
     const float *prev_matrix = next_matrix - 4 * 4;
 
-    ngli_mat4_mul(next_matrix, prev_matrix, s->matrix);
+    ngli_mat4_mul(next_matrix, prev_matrix, matrix);
     ngli_node_draw(child);
     ngli_darray_pop(&ctx->modelview_matrix_stack);
 }
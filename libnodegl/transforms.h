@@ -24,7 +24,18 @@
 
 #include "nodes.h"
 
-const float *ngli_get_last_transformation_matrix(const struct ngl_node *node);
+/*
+ * Transformation chains are lists of transform nodes ending with an Identity
+ * node; their matrix is evaluated without going through the draw path.
+ * ngli_transform_chain_check() must be called at init before using the other
+ * functions on a chain.
+ */
+int ngli_transform_chain_check(const struct ngl_node *node);
+int ngli_transform_chain_is_static(const struct ngl_node *node);
+void ngli_transform_chain_compute(const struct ngl_node *node, float *matrix);
+
+void ngli_transform_set_static(struct ngl_node *node, int is_static);
+void ngli_transform_invalidate_static(struct ngl_node *node);
 void ngli_transform_draw(struct ngl_node *node);
 
 #endif
@@ -25,6 +25,7 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <inttypes.h>
 #if defined(_WIN32) && defined(_MSC_VER)
 #define STDOUT_FILENO _fileno(stdout)
 #define STDERR_FILENO _fileno(stderr)
@@ -68,6 +69,7 @@ struct ctx {
     struct range *ranges;
     int nb_ranges;
     int aspect[2];
+    const char *startup_profile;
 };
 
 static int opt_timerange(const char *arg, void *dst)
@@ -107,8 +109,90 @@ static const struct opt options[] = {
     {"-z", "--swap_interval", OPT_TYPE_INT,      .offset=OFFSET(cfg.swap_interval)},
     {"-c", "--clear_color",   OPT_TYPE_COLOR,    .offset=OFFSET(cfg.clear_color)},
     {"-m", "--samples",       OPT_TYPE_INT,      .offset=OFFSET(cfg.samples)},
+    {"-p", "--startup_profile", OPT_TYPE_STR,    .offset=OFFSET(startup_profile)},
 };
 
+struct phase_time {
+    char name[32];
+    int64_t time;
+};
+
+/*
+ * Return the end of the CSV record starting at p, skipping the line breaks
+ * found in quoted fields
+ */
+static char *find_record_end(char *p)
+{
+    int quoted = 0;
+    for (; *p; p++) {
+        if (*p == '"')
+            quoted = !quoted;
+        else if (*p == '\n' && !quoted)
+            return p;
+    }
+    return NULL;
+}
+
+/*
+ * Write the startup profile (completed with the deserialization time which
+ * happens outside of the context) to the specified CSV file, and print the
+ * time spent in each phase.
+ */
+static int write_startup_profile(struct ngl_ctx *ctx, const char *filename, int64_t deserialize_time)
+{
+    char *report = ngl_get_startup_profile(ctx);
+    if (!report)
+        return NGL_ERROR_MEMORY;
+
+    FILE *fp = fopen(filename, "w");
+    if (!fp) {
+        fprintf(stderr, "Unable to open %s\n", filename);
+        free(report);
+        return NGL_ERROR_IO;
+    }
+    fprintf(fp, "%s,,deserialize,%" PRId64 "\n", report, deserialize_time);
+    fclose(fp);
+
+    struct phase_time phases[16] = {{"deserialize", deserialize_time}};
+    int nb_phases = 1;
+    int64_t total_time = deserialize_time;
+
+    /*
+     * The rows end with the phase and time columns, the (possibly quoted)
+     * label may contain commas and line breaks
+     */
+    char *line = strchr(report, '\n');
+    while (line && *++line) {
+        char *eol = find_record_end(line);
+        if (eol)
+            *eol = 0;
+        char *time_col = strrchr(line, ',');
+        if (time_col) {
+            *time_col = 0;
+            const char *phase = strrchr(line, ',');
+            phase = phase ? phase + 1 : line;
+            const int64_t time = strtoll(time_col + 1, NULL, 10);
+            int i;
+            for (i = 0; i < nb_phases; i++)
+                if (!strcmp(phases[i].name, phase))
+                    break;
+            if (i == nb_phases && nb_phases < ARRAY_NB(phases))
+                snprintf(phases[nb_phases++].name, sizeof(phases[0].name), "%s", phase);
+            if (i < nb_phases)
+                phases[i].time += time;
+            total_time += time;
+        }
+        line = eol;
+    }
+    free(report);
+
+    printf("Startup profile (%g ms):\n", total_time / 1000.);
+    for (int i = 0; i < nb_phases; i++)
+        printf("  %-16s %10.3f ms\n", phases[i].name, phases[i].time / 1000.);
+
+    return 0;
+}
+
 int main(int argc, char *argv[])
 {
     struct ctx s = {
@@ -156,7 +240,9 @@ int main(int argc, char *argv[])
     struct ngl_ctx *ctx = NULL;
     uint8_t *capture_buffer = NULL;
 
+    const int64_t deserialize_start = gettime_relative();
     struct ngl_node *scene = get_scene(s.input);
+    const int64_t deserialize_time = gettime_relative() - deserialize_start;
     if (!scene) {
         ret = EXIT_FAILURE;
         goto end;
@@ -226,7 +312,9 @@ int main(int argc, char *argv[])
             if (s.debug)
                 printf("draw @ t=%f [range %d/%d: %g-%g @ %dHz]\n",
                        t, i + 1, s.nb_ranges, t0, t1, r->freq);
-            ret = ngl_draw(ctx, t);
+            /* Without capture, the events are processed while the frame is
+             * being rendered */
+            ret = capture_buffer ? ngl_draw(ctx, t) : ngl_draw_async(ctx, t);
             if (ret < 0) {
                 fprintf(stderr, "Unable to draw @ t=%g\n", t);
                 goto end;
@@ -238,6 +326,13 @@ int main(int argc, char *argv[])
                 while (SDL_PollEvent(&event)) {
                 }
             }
+            if (!capture_buffer) {
+                ret = ngl_wait(ctx);
+                if (ret < 0) {
+                    fprintf(stderr, "Unable to draw @ t=%g\n", t);
+                    goto end;
+                }
+            }
 
             k++;
         }
@@ -246,6 +341,12 @@ int main(int argc, char *argv[])
         printf("Rendered %d frames in %g (FPS=%g)\n", k, tdiff, k / tdiff);
     }
 
+    if (s.startup_profile) {
+        ret = write_startup_profile(ctx, s.startup_profile, deserialize_time);
+        if (ret < 0)
+            goto end;
+    }
+
 end:
     ngl_freep(&ctx);
 
@@ -20,20 +20,27 @@
 # under the License.
 #
 
+import atexit
 import importlib
 import inspect
 import os
 import os.path as op
 import pickle
 import pkgutil
+import struct
 import subprocess
 import sys
+import threading
+import time
 import traceback
 import pynodegl as ngl
 from pynodegl_utils.filetracker import FileTracker
 
 
-IPC_READ_BUFSIZE = 4096
+IPC_READ_BUFSIZE = 65536
+IPC_HEADER_FMT = '<Q'
+IPC_HEADER_SIZE = struct.calcsize(IPC_HEADER_FMT)
+WORKER_EXIT_TIMEOUT = 2
 
 
 def load_script(path):
@@ -46,46 +53,103 @@ def load_script(path):
     return module
 
 
-def query_subproc(**idict):
+class _Worker:
 
     '''
-    Run the query in a sub-process. IPC happens using pipes and pickle
-    serialization of dict.
+    Long-lived scene builder process. IPC happens using pipes and pickle
+    serialization of dict, each message being prefixed with its size.
+
+    The parent process writes the queries to the writable input fd (fd_w)
+    and reads the results from the readable output fd (fd_r). The executed
+    child (ngl-com sub-process) reads the queries from the readable input fd
+    (child_fd_r) and writes the results to the writable output fd
+    (child_fd_w) until its input is closed.
+
+    Keeping the process alive avoids paying the interpreter startup and the
+    import of pynodegl and the scene modules for every query, while a crash
+    in the user code is still contained in the child: the worker is simply
+    respawned on the next query.
+    '''
 
-    The parent process will write the query to the writable input fd
-    (fd_w) and read the result from the readable output fd (fd_r).
+    def __init__(self):
+        self._lock = threading.Lock()
+        self._proc = None
+        self._fd_r = self._fd_w = None
+
+    def _start(self):
+        child_fd_r, self._fd_w = os.pipe()
+        self._fd_r, child_fd_w = os.pipe()
+
+        cmd = [sys.executable, '-m', 'pynodegl_utils.com', str(child_fd_r), str(child_fd_w)]
+        self._proc = subprocess.Popen(cmd, pass_fds=(child_fd_r, child_fd_w))
+        os.close(child_fd_r)
+        os.close(child_fd_w)
+
+    def _stop(self):
+        if self._proc is None:
+            return
+        os.close(self._fd_w)
+        os.close(self._fd_r)
+        self._fd_r = self._fd_w = None
+        try:
+            self._proc.wait(timeout=WORKER_EXIT_TIMEOUT)
+        except subprocess.TimeoutExpired:
+            self._proc.kill()
+            self._proc.wait()
+        self._proc = None
+
+    def stop(self):
+        with self._lock:
+            self._stop()
+
+    def query(self, idict):
+        with self._lock:
+            if self._proc is None:
+                self._start()
+            try:
+                _write_msg(self._fd_w, idict)
+                return _read_msg(self._fd_r)
+            except (OSError, EOFError, pickle.UnpicklingError):
+                self._stop()
+                return {
+                    'error': 'Scene builder process died unexpectedly:\n' + traceback.format_exc(),
+                    'filelist': set(),
+                }
+
+
+_worker = _Worker()
+atexit.register(_worker.stop)
 
-    The executed child (ngl-com sub-process) will read the query from the
-    readable input fd (child_fd_r) and write result to writable output fd
-    (child_fd_w).
-    '''
 
-    child_fd_r, fd_w = os.pipe()
-    fd_r, child_fd_w = os.pipe()
+def query_subproc(**idict):
 
-    cmd = [sys.executable, '-m', 'pynodegl_utils.com', str(child_fd_r), str(child_fd_w)]
-    ret = subprocess.Popen(cmd, pass_fds=(child_fd_r, child_fd_w))
-    os.close(child_fd_r)
-    os.close(child_fd_w)
+    '''
+    Run the query in the persistent scene builder sub-process.
+    '''
 
-    # Send input
-    idata = pickle.dumps(idict)
-    os.write(fd_w, idata)
-    os.close(fd_w)
+    return _worker.query(idict)
 
-    # Receive output
-    odata = b''
-    while True:
-        rdata = os.read(fd_r, IPC_READ_BUFSIZE)
+
+def _read_exact(fd, size):
+    data = b''
+    while len(data) < size:
+        rdata = os.read(fd, min(size - len(data), IPC_READ_BUFSIZE))
         if not rdata:
-            break
-        odata += rdata
-    os.close(fd_r)
-    odict = pickle.loads(odata)
+            raise EOFError
+        data += rdata
+    return data
 
-    ret.wait()
 
-    return odict
+def _read_msg(fd):
+    size, = struct.unpack(IPC_HEADER_FMT, _read_exact(fd, IPC_HEADER_SIZE))
+    return pickle.loads(_read_exact(fd, size))
+
+
+def _write_msg(fd, obj):
+    data = pickle.dumps(obj)
+    data = struct.pack(IPC_HEADER_FMT, len(data)) + data
+    while data:
+        data = data[os.write(fd, data):]
 
 
 def query_inplace(**idict):
@@ -94,11 +158,16 @@ def query_inplace(**idict):
     Run the query in-place.
     '''
 
+    return _query(idict)
+
+
+def _query(idict, start_files=None):
+
     module_pkgname = idict['pkg']
     module_is_script = module_pkgname.endswith('.py')
 
     # Start tracking the imported modules and opened files
-    ftrack = FileTracker()
+    ftrack = FileTracker(start_files)
     ftrack.start_hooking()
 
     odict = {}
@@ -170,26 +239,140 @@ def query_inplace(**idict):
     return odict
 
 
+class _ModuleCache:
+
+    '''
+    Keep track of the modules imported by the queries so that only the ones
+    whose source changed (and the modules referencing them) are imported
+    again by the next query. The modules loaded before the first query
+    (pynodegl and its dependencies) are never reloaded.
+
+    A cached module does not open again the files it reads at import time:
+    the files opened by the query importing a module are kept along with it,
+    so that they are still reported by the next queries and that a change in
+    any of them imports the module again.
+    '''
+
+    def __init__(self):
+        self._base_modules = set(sys.modules.keys())
+        self.base_files = FileTracker().get_trackable_files()
+        self._mtimes = {}
+        self._files = {}
+
+    @staticmethod
+    def _get_file_mtime(path):
+        try:
+            return os.stat(path).st_mtime_ns
+        except OSError:
+            return -1
+
+    @classmethod
+    def _get_mtime(cls, module):
+        path = getattr(module, '__file__', None)
+        if path is None:
+            return None
+        return cls._get_file_mtime(path)
+
+    def _user_modules(self):
+        return {name: mod for name, mod in sys.modules.items()
+                if name not in self._base_modules and mod is not None}
+
+    @staticmethod
+    def _references(module, names):
+        for obj in vars(module).values():
+            if inspect.ismodule(obj):
+                if obj.__name__ in names:
+                    return True
+            elif getattr(obj, '__module__', None) in names:
+                return True
+        return False
+
+    def _files_changed(self, name):
+        files = self._files.get(name, {})
+        return any(self._get_file_mtime(path) != mtime for path, mtime in files.items())
+
+    @property
+    def files(self):
+        return set().union(*self._files.values())
+
+    def invalidate(self):
+        modules = self._user_modules()
+        stale = set()
+        for name, module in modules.items():
+            mtime = self._get_mtime(module)
+            if name in self._mtimes and (self._mtimes[name] != mtime or self._files_changed(name)):
+                stale.add(name)
+
+        # Modules holding references to a stale module need to be imported
+        # again as well, otherwise they would keep using the old code
+        while stale:
+            dependents = set(name for name, module in modules.items()
+                             if name not in stale and self._references(module, stale))
+            if not dependents:
+                break
+            stale |= dependents
+
+        for name in stale:
+            del sys.modules[name]
+            self._mtimes.pop(name, None)
+            self._files.pop(name, None)
+
+        # New modules may have been added since the last query
+        importlib.invalidate_caches()
+
+    def update(self, filelist):
+        for name, module in self._user_modules().items():
+            if name not in self._mtimes:
+                self._mtimes[name] = self._get_mtime(module)
+                self._files[name] = {path: self._get_file_mtime(path) for path in filelist}
+
+
+def _bench(pkg, module_name, scene_name, nb_runs):
+    idict = dict(query='scene', pkg=pkg, scene=(module_name, scene_name))
+    for mode in ('respawn', 'persistent'):
+        latencies = []
+        for i in range(nb_runs):
+            if mode == 'respawn':
+                _worker.stop()
+            start = time.perf_counter()
+            odict = query_subproc(**idict)
+            latencies.append(time.perf_counter() - start)
+            if 'error' in odict:
+                sys.stderr.write(odict['error'])
+                sys.exit(1)
+        latencies.sort()
+        print('%-10s min:%8.2fms median:%8.2fms max:%8.2fms' % (
+              mode, latencies[0] * 1000, latencies[len(latencies) // 2] * 1000, latencies[-1] * 1000))
+    _worker.stop()
+
+
 # Entry point for the ngl-com tool
 def run():
+    if len(sys.argv) >= 5 and sys.argv[1] == 'bench':
+        nb_runs = int(sys.argv[5]) if len(sys.argv) > 5 else 10
+        _bench(sys.argv[2], sys.argv[3], sys.argv[4], nb_runs)
+        return
+
     fd_r, fd_w = int(sys.argv[1]), int(sys.argv[2])
+    modcache = _ModuleCache()
 
-    # Read input
-    idata = b''
     while True:
-        rdata = os.read(fd_r, IPC_READ_BUFSIZE)
-        if not rdata:
+        # Read input, stop when the parent closes the pipe
+        try:
+            idict = _read_msg(fd_r)
+        except EOFError:
             break
-        idata += rdata
-    os.close(fd_r)
-    idict = pickle.loads(idata)
 
-    # Execute the query
-    odict = query_inplace(**idict)
+        # Execute the query
+        modcache.invalidate()
+        odict = _query(idict, modcache.base_files)
+        modcache.update(odict['filelist'])
+        odict['filelist'] |= modcache.files
+
+        # Write output
+        _write_msg(fd_w, odict)
 
-    # Write output
-    odata = pickle.dumps(odict)
-    os.write(fd_w, odata)
+    os.close(fd_r)
     os.close(fd_w)
 
 
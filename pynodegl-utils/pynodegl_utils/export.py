@@ -21,7 +21,9 @@
 
 import os
 import os.path as op
+import queue
 import subprocess
+import threading
 
 import pynodegl as ngl
 from PySide2 import QtGui, QtCore
@@ -30,6 +32,12 @@ from .com import query_inplace
 from .misc import get_backend, get_viewport, get_nodegl_tempdir
 
 
+# Number of capture buffers cycling between node.gl and the encoder: one is
+# being rendered into while the others are queued or being written to the
+# encoder pipe
+EXPORT_NB_FRAME_SLOTS = 3
+
+
 class Exporter(QtCore.QThread):
 
     progressed = QtCore.Signal(int)
@@ -87,7 +95,17 @@ class Exporter(QtCore.QThread):
         reader = subprocess.Popen(cmd, pass_fds=(fd_r,))
         os.close(fd_r)
 
-        capture_buffer = bytearray(width * height * 4)
+        # The frame slots are shared between the rendering (this thread) and
+        # the encoder feeding thread: node.gl captures directly into a free
+        # slot while the previous frames are being written to the encoder
+        free_slots = queue.Queue()
+        filled_slots = queue.Queue()
+        for i in range(EXPORT_NB_FRAME_SLOTS):
+            free_slots.put(bytearray(width * height * 4))
+        self._feed_error = None
+        feeder = threading.Thread(target=self._feed_encoder, args=(fd_w, filled_slots, free_slots))
+        feeder.start()
+        capture_buffer = free_slots.get()
 
         # node.gl context
         ctx = ngl.Context()
@@ -104,26 +122,66 @@ class Exporter(QtCore.QThread):
         )
         ctx.set_scene_from_string(cfg['scene'])
 
+        draw_ret = 0
         if self._time is not None:
             ctx.draw(self._time)
-            os.write(fd_w, capture_buffer)
+            filled_slots.put(capture_buffer)
             self.progressed.emit(100)
         else:
-            # Draw every frame
+            # Draw every frame: each frame is queued asynchronously, the next
+            # free slot is fetched while it is being rendered, and its slot is
+            # handed to the encoder once the frame is complete
             nb_frame = int(duration * fps[0] / fps[1])
             for i in range(nb_frame):
                 if self._cancelled:
                     break
                 time = i * fps[1] / float(fps[0])
-                ctx.draw(time)
-                os.write(fd_w, capture_buffer)
+                draw_ret = ctx.draw_async(time)
+                if draw_ret < 0:
+                    break
                 self.progressed.emit(i*100 / nb_frame)
+                next_buffer = free_slots.get() if i < nb_frame - 1 else None
+                draw_ret = ctx.wait()
+                if draw_ret < 0:
+                    break
+                if next_buffer is not None:
+                    ctx.set_capture_buffer(next_buffer)
+                filled_slots.put(capture_buffer)
+                capture_buffer = next_buffer
             self.progressed.emit(100)
 
-        os.close(fd_w)
+        del ctx
+        filled_slots.put(None)
+        feeder.join()
         reader.wait()
+
+        if draw_ret < 0:
+            print('Unable to draw @ t=%g' % time)
+            self.failed.emit()
+            return False
+        if self._feed_error is not None:
+            print('Error while writing to the encoder: %s' % self._feed_error)
+            self.failed.emit()
+            return False
         return True
 
+    def _feed_encoder(self, fd_w, filled_slots, free_slots):
+        while True:
+            frame = filled_slots.get()
+            if frame is None:
+                break
+            # Keep recycling the slots after a write error so the rendering
+            # never blocks on a dead encoder
+            if self._feed_error is None:
+                try:
+                    view = memoryview(frame)
+                    while view:
+                        view = view[os.write(fd_w, view):]
+                except OSError as e:
+                    self._feed_error = e
+            free_slots.put(frame)
+        os.close(fd_w)
+
     def cancel(self):
         self._cancelled = True
 
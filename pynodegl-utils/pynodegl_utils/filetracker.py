@@ -28,8 +28,9 @@ import distutils.sysconfig
 
 class FileTracker:
 
-    def __init__(self):
+    def __init__(self, start_files=None):
         self.filelist = set()
+        self._start_files = start_files
         self._builtin_open = builtins.open
         self._pysysdir = op.realpath(distutils.sysconfig.get_python_lib(standard_lib=True))
 
@@ -39,7 +40,7 @@ class FileTracker:
             self.filelist.update([op.realpath(name)])
         return ret
 
-    def _get_trackable_files(self):
+    def get_trackable_files(self):
         files = set()
         for mod in sys.modules.values():
             if not hasattr(mod, '__file__') or mod.__file__ is None:
@@ -56,10 +57,11 @@ class FileTracker:
         return files
 
     def start_hooking(self):
-        self._start_files = self._get_trackable_files()
+        if self._start_files is None:
+            self._start_files = self.get_trackable_files()
         builtins.open = self._open_hook
 
     def end_hooking(self):
-        new_files = self._get_trackable_files() - self._start_files
+        new_files = self.get_trackable_files() - self._start_files
         self.filelist.update(new_files)
         builtins.open = self._builtin_open
@@ -20,16 +20,26 @@
 # under the License.
 #
 
+import concurrent.futures
 import hashlib
 import os
 import os.path as op
 import tempfile
 import subprocess
+import threading
 import time
 
 from PySide2 import QtCore
 
 
+SYNC_MAX_WORKERS = 4
+SYNC_POLL_INTERVAL = 0.1
+
+
+class HooksCancelled(Exception):
+    pass
+
+
 class _HooksCaller:
 
     _HOOKS = ('get_session_info', 'get_sessions', 'scene_change', 'sync_file')
@@ -115,12 +125,31 @@ class _HooksCaller:
         return self._get_hook_output('sync_file', session_id, localfile, self._hash_filename(localfile))
 
 
+class _SyncTask:
+
+    def __init__(self, future):
+        self.future = future
+        self.refcount = 0
+
+
 class HooksCaller:
 
     def __init__(self, hooksdirs):
         self._callers = [_HooksCaller(hooksdir) for hooksdir in hooksdirs]
         self.hooks_available = any(c.hooks_available for c in self._callers)
 
+        # Uploads are shared between all the sessions and batches: the
+        # executor bounds the number of concurrent sync_file hooks, the
+        # remote files are remembered per session and hashed filename so that
+        # unchanged files are never sent twice, and in-flight uploads are
+        # reused by the batches requesting the same file. The remote files
+        # are forgotten whenever the sessions are listed again (a session may
+        # have reconnected and lost them) and when a synchronization fails.
+        self._executor = concurrent.futures.ThreadPoolExecutor(max_workers=SYNC_MAX_WORKERS)
+        self._sync_lock = threading.Lock()
+        self._synced_files = {}
+        self._sync_tasks = {}
+
     def _get_caller_session_id(self, unique_session_id):
         istr, session_id = unique_session_id.split(':', maxsplit=1)
         return self._callers[int(istr)], session_id
@@ -136,6 +165,8 @@ class HooksCaller:
         This methods makes these session IDs unique by adding the index of
         the caller as prefix.
         '''
+        with self._sync_lock:
+            self._synced_files.clear()
         sessions = []
         for caller_id, caller in enumerate(self._callers):
             caller_sessions = caller.get_sessions()
@@ -155,6 +186,84 @@ class HooksCaller:
         caller, session_id = self._get_caller_session_id(session_id)
         return caller.sync_file(session_id, localfile)
 
+    def _sync_file_task(self, key, session_id, localfile):
+        remotefile = self.sync_file(session_id, localfile)
+        with self._sync_lock:
+            self._synced_files[key] = remotefile
+        return remotefile
+
+    def _forget_synced_files(self, session_id):
+        with self._sync_lock:
+            for key in [key for key in self._synced_files if key[0] == session_id]:
+                del self._synced_files[key]
+
+    def _acquire_sync_task(self, session_id, localfile):
+        key = (session_id, _HooksCaller._hash_filename(localfile))
+        with self._sync_lock:
+            remotefile = self._synced_files.get(key)
+            if remotefile is not None:
+                return key, remotefile
+            task = self._sync_tasks.get(key)
+            if task is None:
+                future = self._executor.submit(self._sync_file_task, key, session_id, localfile)
+                task = _SyncTask(future)
+                self._sync_tasks[key] = task
+            task.refcount += 1
+            return key, task
+
+    def _release_sync_task(self, key, task, cancel):
+        with self._sync_lock:
+            task.refcount -= 1
+            if task.refcount == 0 and self._sync_tasks.get(key) is task:
+                if cancel:
+                    task.future.cancel()
+                del self._sync_tasks[key]
+
+    def sync_files(self, session_id, filelist, cancel_event=None, progress_cb=None):
+        '''
+        Synchronize a list of files concurrently and return a dict mapping
+        each local file to its remote counterpart.
+
+        If cancel_event is set while the files are being synchronized,
+        HooksCancelled is raised and the uploads which are not started yet
+        (and not needed by any other batch) are dropped. The uploads already
+        running are completed and recorded so a subsequent batch will not
+        send them again.
+        '''
+        filelist = list(dict.fromkeys(filelist))
+        remotefiles = {}
+        tasks = {}
+        nb_files = len(filelist)
+        try:
+            for localfile in filelist:
+                key, task = self._acquire_sync_task(session_id, localfile)
+                if isinstance(task, _SyncTask):
+                    tasks[task.future] = (key, task, localfile)
+                else:
+                    remotefiles[localfile] = task
+
+            pending = set(tasks.keys())
+            while pending:
+                if cancel_event is not None and cancel_event.is_set():
+                    raise HooksCancelled()
+                done, pending = concurrent.futures.wait(pending, timeout=SYNC_POLL_INTERVAL,
+                                                        return_when=concurrent.futures.FIRST_COMPLETED)
+                for future in done:
+                    key, task, localfile = tasks.pop(future)
+                    self._release_sync_task(key, task, cancel=False)
+                    try:
+                        remotefiles[localfile] = future.result()
+                    except Exception:
+                        self._forget_synced_files(session_id)
+                        raise
+                    if progress_cb:
+                        progress_cb(len(remotefiles), nb_files, localfile)
+        finally:
+            for key, task, _ in tasks.values():
+                self._release_sync_task(key, task, cancel=True)
+
+        return remotefiles
+
 
 class _HooksThread(QtCore.QThread):
 
@@ -166,6 +275,7 @@ class _HooksThread(QtCore.QThread):
 
     def __init__(self, get_scene_func, hooks_caller, session_id, backend, system, module_name, scene_name):
         super().__init__()
+        self._cancel_event = threading.Event()
         self._get_scene_func = get_scene_func
         self._hooks_caller = hooks_caller
         self._session_id = session_id
@@ -177,6 +287,9 @@ class _HooksThread(QtCore.QThread):
         self._target_backend = backend
         self._target_system = system
 
+    def cancel(self):
+        self._cancel_event.set()
+
     @staticmethod
     def _filename_escape(filename):
         s = ''
@@ -198,6 +311,10 @@ class _HooksThread(QtCore.QThread):
             self.error.emit(session_id, 'Error getting scene')
             return
 
+        # A newer scene was submitted while this one was being built
+        if self._cancel_event.is_set():
+            return
+
         try:
             # The serialized scene is associated with a bunch of assets which we
             # need to sync. Similarly, the remote assets directory might be
@@ -205,17 +322,22 @@ class _HooksThread(QtCore.QThread):
             # appropriately.
             serialized_scene = cfg['scene'].decode('ascii')
             filelist = [m.filename for m in cfg['medias']] + cfg['files']
-            for i, localfile in enumerate(filelist, 1):
-                self.uploadingFile.emit(session_id, i, len(filelist), localfile)
-                try:
-                    remotefile = self._hooks_caller.sync_file(session_id, localfile)
-                except subprocess.CalledProcessError as e:
-                    self.error.emit(session_id, 'Error (%d) while uploading %s' % (e.returncode, localfile))
-                    return
+            progress_cb = lambda i, n, localfile: self.uploadingFile.emit(session_id, i, n, localfile)
+            try:
+                remotefiles = self._hooks_caller.sync_files(session_id, filelist, self._cancel_event, progress_cb)
+            except HooksCancelled:
+                return
+            except subprocess.CalledProcessError as e:
+                self.error.emit(session_id, 'Error (%d) while uploading %s' % (e.returncode, e.cmd[2]))
+                return
+            for localfile, remotefile in remotefiles.items():
                 serialized_scene = serialized_scene.replace(
                         self._filename_escape(localfile),
                         self._filename_escape(remotefile))
 
+            if self._cancel_event.is_set():
+                return
+
             # The serialized scene is then stored in a file which is then
             # communicated with additional parameters to the user
             # FIXME: this won't work on Windows, see
@@ -244,15 +366,17 @@ class HooksController(QtCore.QObject):
         self._hooks_caller = hooks_caller
         self._threads = []
 
-    def _wait_threads(self):
+    def _cancel_threads(self):
+        # The cancelled threads stop at their next checkpoint; they are kept
+        # referenced until they are actually finished
         for hook_thread in self._threads:
-            hook_thread.wait()
-        self._threads = []
+            hook_thread.cancel()
+        self._threads = [t for t in self._threads if not t.isFinished()]
 
     def process(self, module_name, scene_name):
         if not self._hooks_caller.hooks_available:
             return
-        self._wait_threads()  # Wait previous batch
+        self._cancel_threads()  # Drop the previous batch
         data = self._hooks_view.get_data_from_model()
         for session_id, data_row in data.items():
             if not data_row['checked']:
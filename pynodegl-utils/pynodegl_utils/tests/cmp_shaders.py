@@ -0,0 +1,75 @@
+#!/usr/bin/env python
+#
+# Copyright 2020 GoPro Inc.
+#
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+#
+
+import os
+import re
+import pynodegl as ngl
+from pynodegl_utils.misc import get_backend
+
+from .cmp import CompareSceneBase, get_test_decorator
+
+
+_DECL_RE = re.compile(r'^(?:layout\([^)]*\)\s*)?(?:flat\s+)?(?:uniform|in|out|attribute|varying)\s+'
+                      r'(lowp|mediump|highp)\s+(\w+)\s+(\w+)')
+
+
+class _CompareShaders(CompareSceneBase):
+
+    def __init__(self, scene_func, derive_precision=1, **kwargs):
+        super().__init__(scene_func, width=16, height=16, **kwargs)
+        self._derive_precision = derive_precision
+
+    @staticmethod
+    def _get_declarations(shaders):
+        # Only keep the stage headers and the declarations with a precision
+        # qualifier, the rest of the crafted shaders being irrelevant here
+        ret = ''
+        for line in shaders.splitlines():
+            if line.startswith('// '):
+                ret += line + '\n'
+                continue
+            match = _DECL_RE.match(line)
+            if match:
+                ret += ' '.join(match.groups()) + '\n'
+        return ret
+
+    def get_out_data(self, debug=False, debug_func=None):
+        idict = dict(medias=[])
+
+        backend = os.environ.get('BACKEND')
+        if backend:
+            idict['backend'] = backend
+
+        ret = self._scene_func(idict=idict, **self._scene_kwargs)
+        ctx = ngl.Context()
+        assert ctx.configure(offscreen=1, width=self._width, height=self._height,
+                             backend=get_backend(backend) if backend else ngl.BACKEND_AUTO,
+                             derive_precision=self._derive_precision) == 0
+        ctx.set_scene(ret['scene'])
+        assert ctx.draw(0) == 0
+
+        shaders = ctx.get_shaders()
+        assert shaders is not None
+        return self._get_declarations(shaders)
+
+
+test_shaders = get_test_decorator(_CompareShaders)
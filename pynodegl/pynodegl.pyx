@@ -22,6 +22,7 @@
 
 from libc.stdlib cimport calloc
 from libc.string cimport memset
+from libc.stdint cimport int64_t
 from libc.stdint cimport uint8_t
 from libc.stdint cimport uintptr_t
 
@@ -93,6 +94,7 @@ cdef extern from "nodegl.h":
         uintptr_t display
         uintptr_t window
         uintptr_t handle
+        ngl_ctx *share_ctx
         int  swap_interval
         int  offscreen
         int  width
@@ -103,6 +105,10 @@ cdef extern from "nodegl.h":
         float clear_color[4]
         void *capture_buffer
         int capture_buffer_type
+        int64_t gpu_memory_budget
+        int release_host_data
+        int quantize_attributes
+        int derive_precision
         int hud
         int hud_measure_window
         int hud_refresh_rate[2]
@@ -114,9 +120,13 @@ cdef extern from "nodegl.h":
     void ngl_backends_freep(ngl_backend **backendsp)
     int ngl_configure(ngl_ctx *s, ngl_config *config)
     int ngl_resize(ngl_ctx *s, int width, int height, const int *viewport);
-    int ngl_set_capture_buffer(ngl_ctx *s, void *capture_buffer);
+    int ngl_set_capture_buffer(ngl_ctx *s, void *capture_buffer) nogil
     int ngl_set_scene(ngl_ctx *s, ngl_node *scene)
     int ngl_draw(ngl_ctx *s, double t) nogil
+    int ngl_draw_async(ngl_ctx *s, double t) nogil
+    int ngl_wait(ngl_ctx *s) nogil
+    char *ngl_get_startup_profile(ngl_ctx *s) nogil
+    char *ngl_get_shaders(ngl_ctx *s) nogil
     char *ngl_dot(ngl_ctx *s, double t) nogil
     void ngl_freep(ngl_ctx **ss)
 
@@ -253,6 +263,7 @@ cdef class Context:
     cdef ngl_ctx *ctx
     cdef object capture_buffer
     cdef object hud_export_filename
+    cdef object share_ctx
 
     def __cinit__(self):
         self.ctx = ngl_create()
@@ -267,6 +278,9 @@ cdef class Context:
         config.display = kwargs.get('display', 0)
         config.window = kwargs.get('window', 0)
         config.handle = kwargs.get('handle', 0)
+        share_ctx = kwargs.get('share_ctx')
+        if share_ctx is not None:
+            config.share_ctx = (<Context>share_ctx).ctx
         config.swap_interval = kwargs.get('swap_interval', -1)
         config.offscreen = kwargs.get('offscreen', 0)
         config.width = kwargs.get('width', 0)
@@ -282,6 +296,10 @@ cdef class Context:
         capture_buffer = kwargs.get('capture_buffer')
         if capture_buffer is not None:
             config.capture_buffer = <uint8_t *>capture_buffer
+        config.gpu_memory_budget = kwargs.get('gpu_memory_budget', 0)
+        config.release_host_data = kwargs.get('release_host_data', 0)
+        config.quantize_attributes = kwargs.get('quantize_attributes', 0)
+        config.derive_precision = kwargs.get('derive_precision', 0)
         config.hud = kwargs.get('hud', 0)
         config.hud_measure_window = kwargs.get('hud_measure_window', 0)
         hud_refresh_rate = kwargs.get('hud_refresh_rate', (0, 0))
@@ -295,6 +313,7 @@ cdef class Context:
     def configure(self, **kwargs):
         self.capture_buffer = kwargs.get('capture_buffer')
         self.hud_export_filename = kwargs.get('hud_export_filename')
+        self.share_ctx = kwargs.get('share_ctx')
         cdef ngl_config config
         Context._init_ngl_config_from_dict(&config, kwargs)
         return ngl_configure(self.ctx, &config)
@@ -312,7 +331,9 @@ cdef class Context:
         cdef uint8_t *ptr = NULL
         if self.capture_buffer is not None:
             ptr = <uint8_t *>self.capture_buffer
-        return ngl_set_capture_buffer(self.ctx, ptr)
+        with nogil:
+            ret = ngl_set_capture_buffer(self.ctx, ptr)
+        return ret
 
     def set_scene(self, _Node scene):
         return ngl_set_scene(self.ctx, NULL if scene is None else scene.ctx)
@@ -328,6 +349,28 @@ cdef class Context:
             ret = ngl_draw(self.ctx, t)
         return ret
 
+    def draw_async(self, double t):
+        with nogil:
+            ret = ngl_draw_async(self.ctx, t)
+        return ret
+
+    def wait(self):
+        with nogil:
+            ret = ngl_wait(self.ctx)
+        return ret
+
+    def get_startup_profile(self):
+        cdef char *s;
+        with nogil:
+            s = ngl_get_startup_profile(self.ctx)
+        return _ret_pystr(s) if s else None
+
+    def get_shaders(self):
+        cdef char *s;
+        with nogil:
+            s = ngl_get_shaders(self.ctx)
+        return _ret_pystr(s) if s else None
+
     def dot(self, double t):
         cdef char *s;
         with nogil:
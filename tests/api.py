@@ -197,3 +197,49 @@ def api_media_sharing_failure():
     m = ngl.Media('/dev/null')
     scene = ngl.Group(children=(m, m))
     assert _ret_to_fourcc(ctx.set_scene(scene)) == 'Eusg'  # Usage error
+
+
+def _get_userswitch_texture_memory(enabled_states, residency, gpu_memory_budget=0, warm_up=False):
+    import csv
+    import tempfile
+
+    frag = 'void main() { ngl_out_color = ngl_tex2d(tex, vec2(0.5)); }'
+    program = ngl.Program(vertex=_vert, fragment=frag)
+    render = ngl.Render(ngl.Quad(), program)
+    render.update_frag_resources(tex=ngl.Texture2D(width=4, height=4))
+    switch = ngl.UserSwitch(render, residency=residency, warm_up=warm_up)
+
+    with tempfile.TemporaryDirectory(prefix='ngl-test-api-') as tmpdir:
+        export_filename = os.path.join(tmpdir, 'hud.csv')
+        ctx = ngl.Context()
+        assert ctx.configure(offscreen=1, width=16, height=16, backend=_backend,
+                             hud=1, hud_export_filename=export_filename,
+                             gpu_memory_budget=gpu_memory_budget) == 0
+        assert ctx.set_scene(switch) == 0
+        for i, enabled in enumerate(enabled_states):
+            switch.set_enabled(enabled)
+            assert ctx.draw(i) == 0
+        del ctx  # flush the HUD export
+
+        with open(export_filename) as csv_file:
+            return [int(row['Textures memory']) for row in csv.DictReader(csv_file)]
+
+
+# The texture of the switched branch must be held on the GPU according to the
+# residency policy while the branch is disabled
+def api_userswitch_residency():
+    size = 4 * 4 * 4
+    enabled_states = (False, True, False, False)
+    assert _get_userswitch_texture_memory(enabled_states, 'release') == [0, size, 0, 0]
+    assert _get_userswitch_texture_memory(enabled_states, 'keep_warm') == [0, size, size, size]
+    assert _get_userswitch_texture_memory(enabled_states, 'eager') == [size, size, size, size]
+    assert _get_userswitch_texture_memory(enabled_states, 'release', warm_up=True) == [size, size, size, size]
+
+
+# The branches kept warm are released on the frame following the one exceeding
+# the GPU memory budget, and held again once enabled
+def api_userswitch_eviction():
+    size = 4 * 4 * 4
+    enabled_states = (False, False, True, False, False)
+    assert _get_userswitch_texture_memory(enabled_states, 'keep_warm', 1) == [0, 0, size, size, 0]
+    assert _get_userswitch_texture_memory(enabled_states, 'eager', 1) == [size, 0, size, size, 0]
@@ -0,0 +1,81 @@
+#!/usr/bin/env python
+#
+# Copyright 2019 GoPro Inc.
+#
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+#
+
+import os
+import os.path as op
+import sys
+import tempfile
+from pynodegl_utils.com import query_subproc
+
+
+_SCENE_MODULE = '''
+import os.path as op
+import pynodegl as ngl
+from pynodegl_utils.misc import scene
+
+with open(op.join(op.dirname(__file__), 'duration.txt')) as f:
+    _DURATION = float(f.read())
+
+@scene()
+def duration_scene(cfg):
+    cfg.duration = _DURATION
+    return ngl.Group()
+'''
+
+
+def _write_file(path, content):
+    with open(path, 'w') as f:
+        f.write(content)
+    # Make sure the modification is visible even with a coarse mtime
+    # resolution
+    st = os.stat(path)
+    os.utime(path, ns=(st.st_atime_ns, st.st_mtime_ns + 1000000000))
+
+
+def com_filelist_reload():
+    with tempfile.TemporaryDirectory(prefix='ngl-test-com-') as tmpdir:
+        pkg_dir = op.join(tmpdir, 'ngl_test_com_pkg')
+        os.mkdir(pkg_dir)
+        _write_file(op.join(pkg_dir, '__init__.py'), '')
+        _write_file(op.join(pkg_dir, 'scenes.py'), _SCENE_MODULE)
+        duration_file = op.realpath(op.join(pkg_dir, 'duration.txt'))
+        _write_file(duration_file, '2')
+
+        # The persistent worker is spawned by the first query and inherits
+        # the environment
+        os.environ['PYTHONPATH'] = os.pathsep.join([tmpdir] + sys.path)
+        idict = dict(query='scene', pkg='ngl_test_com_pkg', scene=('scenes', 'duration_scene'), medias=[])
+
+        # The file read at import time is reported by the first query, and by
+        # the next ones even though the module is not imported again
+        for i in range(2):
+            odict = query_subproc(**idict)
+            assert 'error' not in odict, odict['error']
+            assert odict['duration'] == 2
+            assert duration_file in odict['filelist']
+
+        # A change in that file imports the module again
+        _write_file(duration_file, '3')
+        odict = query_subproc(**idict)
+        assert 'error' not in odict, odict['error']
+        assert odict['duration'] == 3
+        assert duration_file in odict['filelist']
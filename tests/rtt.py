@@ -259,3 +259,43 @@ def rtt_clear_attachment_with_timeranges(cfg):
     render.update_frag_resources(tex0=texture)
 
     return ngl.Group(children=(rtt, render))
+
+
+@test_cuepoints(width=32, height=32, points={'parent': (-0.5, 0), 'nested-parent': (0.25, 0), 'nested-cleared': (0.75, 0)}, nb_keyframes=2, tolerance=1)
+@scene()
+def rtt_nested_sample_parent(cfg):
+    # The nested RTT samples the target of its parent while it is being
+    # rendered: it must see the content drawn so far in the current frame
+    # (the left half), not the one from the previous frame
+    texture_parent = ngl.Texture2D(width=32, height=32)
+    texture_nested = ngl.Texture2D(width=32, height=32)
+
+    quad = ngl.Quad((-1, -1, 0), (1, 0, 0), (0, 2, 0))
+    program = ngl.Program(vertex=cfg.get_vert('color'), fragment=cfg.get_frag('color'))
+    program.update_vert_out_vars(var_tex0_coord=ngl.IOVec2(), var_uvcoord=ngl.IOVec2())
+    left = ngl.Render(quad, program)
+    left.update_frag_resources(color=ngl.UniformVec4(value=COLORS['white']))
+
+    quad = ngl.Quad((-1, -1, 0), (2, 0, 0), (0, 2, 0))
+    program = ngl.Program(vertex=cfg.get_vert('texture'), fragment=cfg.get_frag('texture'))
+    program.update_vert_out_vars(var_tex0_coord=ngl.IOVec2(), var_uvcoord=ngl.IOVec2())
+    render = ngl.Render(quad, program)
+    render.update_frag_resources(tex0=texture_parent)
+    rtt_nested = ngl.RenderToTexture(render, [texture_nested], clear_color=(0, 0, 0, 1))
+
+    quad = ngl.Quad((0, -1, 0), (1, 0, 0), (0, 2, 0))
+    program = ngl.Program(vertex=cfg.get_vert('texture'), fragment=cfg.get_frag('texture'))
+    program.update_vert_out_vars(var_tex0_coord=ngl.IOVec2(), var_uvcoord=ngl.IOVec2())
+    right = ngl.Render(quad, program)
+    right.update_frag_resources(tex0=texture_nested)
+
+    group = ngl.Group(children=(left, rtt_nested, right))
+    rtt_parent = ngl.RenderToTexture(group, [texture_parent], clear_color=(0, 0, 0, 1))
+
+    quad = ngl.Quad((-1, -1, 0), (2, 0, 0), (0, 2, 0))
+    program = ngl.Program(vertex=cfg.get_vert('texture'), fragment=cfg.get_frag('texture'))
+    program.update_vert_out_vars(var_tex0_coord=ngl.IOVec2(), var_uvcoord=ngl.IOVec2())
+    render = ngl.Render(quad, program)
+    render.update_frag_resources(tex0=texture_parent)
+
+    return ngl.Group(children=(rtt_parent, render))
@@ -29,6 +29,7 @@ from pynodegl_utils.toolbox.colors import COLORS
 from pynodegl_utils.toolbox.colors import get_random_color_buffer
 from pynodegl_utils.tests.cmp_cuepoints import test_cuepoints
 from pynodegl_utils.tests.cmp_fingerprint import test_fingerprint
+from pynodegl_utils.tests.cmp_shaders import test_shaders
 from pynodegl_utils.toolbox.shapes import equilateral_triangle_coords
 from pynodegl_utils.toolbox.grid import autogrid_simple
 
@@ -57,6 +58,32 @@ void main()
     return scene
 
 
+@test_shaders()
+@scene()
+def shape_derived_precision(cfg):
+    # The live-changeable uniform stays highp, the animation between 0 and 0.9
+    # is mediump and the quad attributes, all within [-1,1], are lowp
+    vert = '''
+void main()
+{
+    ngl_out_pos = ngl_projection_matrix * ngl_modelview_matrix * vec4(ngl_position.xy * scale, 0.0, 1.0);
+}
+'''
+    frag = '''
+void main()
+{
+    ngl_out_color = vec4(1.0, 0.5, 0.0, alpha);
+}
+'''
+    animkf = [ngl.AnimKeyFrameFloat(0, 0), ngl.AnimKeyFrameFloat(cfg.duration, .9)]
+    program = ngl.Program(vertex=vert, fragment=frag)
+    geometry = ngl.Quad(corner=(-1, -1, 0), width=(2, 0, 0), height=(0, 2, 0))
+    render = ngl.Render(geometry, program)
+    render.update_vert_resources(scale=ngl.UniformFloat(value=1))
+    render.update_frag_resources(alpha=ngl.AnimatedFloat(animkf))
+    return render
+
+
 def _render_shape(cfg, geometry, color):
     prog = ngl.Program(vertex=cfg.get_vert('color'), fragment=cfg.get_frag('color'))
     render = ngl.Render(geometry, prog)